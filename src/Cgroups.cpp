@@ -0,0 +1,254 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <dirent.h>
+#include <cstring>
+#include <algorithm>
+#include <vector>
+#include <Log.hpp>
+
+#include "Cgroups.hpp"
+
+CgroupNode::CgroupNode(const Glib::ustring& name, const Glib::ustring& key, const pProcessHistory& history)
+: psc::gl::NamedTreeNode2(name, key)
+, m_history{history}
+, m_historyIndex{history->allocate()}
+, m_stage{psc::gl::TreeNodeState::New}
+, m_touched{true}
+, m_usageUsec{0}
+, m_memoryBytes{0}
+, m_load{0.0}
+, m_memLoad{0.0}
+{
+}
+
+CgroupNode::~CgroupNode()
+{
+    m_history->release(m_historyIndex);
+}
+
+float
+CgroupNode::getLoad()
+{
+    int c10 = static_cast<int>(m_load * 10.0);
+    return static_cast<float>(c10) / 10.0f;    // same granularity as processes, to not redraw too often
+}
+
+psc::gl::TreeNodeState
+CgroupNode::getStage()
+{
+    return m_stage;
+}
+
+// the group came back, the counters start again
+void
+CgroupNode::restart()
+{
+    m_stage = psc::gl::TreeNodeState::Running;
+    m_usageUsec = 0u;
+    m_load = 0.0;
+}
+
+bool
+CgroupNode::readFile(int dirFd, const char* name, ProcReader& reader)
+{
+    int fd = openat(dirFd, name, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        return false;   // e.g. the root has no memory.current, or the controller is not enabled
+    }
+    bool ret = reader.read(fd);
+    close(fd);
+    return ret;
+}
+
+// compare the key at the start of pos, returns the position after it or nullptr
+static const char*
+afterKey(const char* pos, const char* end, const char* key, size_t keyLen)
+{
+    return static_cast<size_t>(end - pos) >= keyLen
+        && std::memcmp(pos, key, keyLen) == 0 ? pos + keyLen : nullptr;
+}
+
+void
+CgroupNode::read(int dirFd, ProcReader& reader, gint64 elapsedUs, double cpus, double memTotal)
+{
+    if (readFile(dirFd, "cpu.stat", reader)) {
+        const char* end = reader.end();
+        const char* val = afterKey(reader.begin(), end, "usage_usec ", 11);  // first line
+        if (val) {
+            uint64_t usageUsec;
+            ProcReader::scanUnsigned(val, end, usageUsec);
+            if (m_usageUsec > 0u
+             && usageUsec >= m_usageUsec
+             && elapsedUs > 0) {
+                m_load = static_cast<double>(usageUsec - m_usageUsec) / (static_cast<double>(elapsedUs) * cpus);
+            }
+            m_usageUsec = usageUsec;
+        }
+    }
+    if (readFile(dirFd, "memory.current", reader)) {
+        ProcReader::scanUnsigned(reader.begin(), reader.end(), m_memoryBytes);
+        m_memLoad = memTotal > 0.0 ? static_cast<double>(m_memoryBytes) / memTotal : 0.0;
+    }
+    m_history->set(ProcessHistory::CPU, m_historyIndex, static_cast<float>(m_load));
+    m_history->set(ProcessHistory::MEM, m_historyIndex, static_cast<float>(m_memLoad));
+}
+
+void
+CgroupNode::addCpuData(Buffer<double>& buffer) const
+{
+    m_history->addTo(ProcessHistory::CPU, m_historyIndex, buffer);
+}
+
+void
+CgroupNode::addMemData(Buffer<double>& buffer) const
+{
+    m_history->addTo(ProcessHistory::MEM, m_historyIndex, buffer);
+}
+
+CgroupCollector::CgroupCollector(uint32_t slots, const std::string& cgroupDir)
+: m_cgroupDir{unifiedDir(cgroupDir)}
+, m_history{std::make_shared<ProcessHistory>(slots)}
+, m_lastUpdate{0}
+, m_cpus{static_cast<double>(std::max(sysconf(_SC_NPROCESSORS_ONLN), 1l))}
+, m_memTotal{static_cast<double>(sysconf(_SC_PHYS_PAGES)) * static_cast<double>(sysconf(_SC_PAGESIZE))}
+, m_treeChanged{true}
+{
+}
+
+// with the hybrid layout the v2 hierarchy is mounted below
+std::string
+CgroupCollector::unifiedDir(const std::string& cgroupDir)
+{
+    if (access((cgroupDir + "/cgroup.controllers").c_str(), F_OK) != 0
+     && access((cgroupDir + "/unified/cgroup.controllers").c_str(), F_OK) == 0) {
+        return cgroupDir + "/unified";
+    }
+    return cgroupDir;
+}
+
+pCgroupNode
+CgroupCollector::find(const std::string& key) const
+{
+    auto entry = m_groups.find(key);
+    return entry != m_groups.end() ? entry->second : pCgroupNode{};
+}
+
+pCgroupNode
+CgroupCollector::touch(const pCgroupNode& parent, const std::string& name, const std::string& key)
+{
+    auto entry = m_groups.find(key);
+    if (entry != m_groups.end()) {
+        auto& node = entry->second;
+        node->setTouched(true);
+        if (node->getStage() == psc::gl::TreeNodeState::New) {
+            node->setStage(psc::gl::TreeNodeState::Running);
+        }
+        else if (node->getStage() == psc::gl::TreeNodeState::Close) {
+            node->restart();    // missed by a walk (e.g. a service recreates its group on restart)
+        }
+        return node;
+    }
+    auto node = std::make_shared<CgroupNode>(name, key, m_history);
+    if (parent) {
+        node->setParent(parent.get(), node);
+    }
+    m_groups.emplace(key, node);
+    m_treeChanged = true;
+    return node;
+}
+
+// depth first, each directory is opened relative to its parent
+void
+CgroupCollector::walk(int dirFd, const pCgroupNode& parent, const std::string& key, gint64 elapsedUs)
+{
+    DIR* dir = fdopendir(dirFd);   // takes the fd
+    if (dir == nullptr) {
+        close(dirFd);
+        return;
+    }
+    struct dirent* entry;
+    while ((entry = readdir(dir)) != nullptr) {
+        if (entry->d_type == DT_DIR
+         && entry->d_name[0] != '.') {
+            int childFd = openat(dirfd(dir), entry->d_name, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+            if (childFd >= 0) {
+                std::string childKey = key.empty() ? std::string(entry->d_name) : key + "/" + entry->d_name;
+                auto node = touch(parent, entry->d_name, childKey);
+                node->read(childFd, m_reader, elapsedUs, m_cpus, m_memTotal);
+                walk(childFd, node, childKey, elapsedUs);
+            }
+        }
+    }
+    closedir(dir);
+}
+
+bool
+CgroupCollector::update()
+{
+    int rootFd = open(m_cgroupDir.c_str(), O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (rootFd < 0) {
+        return false;
+    }
+    gint64 now = g_get_monotonic_time();
+    gint64 elapsedUs = m_lastUpdate > 0 ? now - m_lastUpdate : 0;
+    m_lastUpdate = now;
+    m_history->roll();
+    for (auto& entry : m_groups) {
+        entry.second->setTouched(false);
+    }
+    m_root = touch(pCgroupNode{}, "/", "");
+    m_root->read(rootFd, m_reader, elapsedUs, m_cpus, m_memTotal);
+    walk(rootFd, m_root, "", elapsedUs);
+    std::vector<std::string> removed;
+    for (auto& entry : m_groups) {
+        auto& node = entry.second;
+        if (!node->isTouched()) {   // close in 2 steps to show status, as processes
+            if (node->getStage() < psc::gl::TreeNodeState::Close) {
+                node->setStage(psc::gl::TreeNodeState::Close);
+            }
+            else {
+                removed.push_back(entry.first);
+            }
+        }
+    }
+    // children first, so no child is left with a removed parent
+    std::sort(removed.begin(), removed.end(), [] (const std::string& a, const std::string& b) {
+        return a.size() > b.size();
+    });
+    for (auto& key : removed) {
+        auto entry = m_groups.find(key);
+        auto parent = entry->second->getParent();
+        if (parent) {
+            parent->remove(entry->second.get());
+        }
+        m_groups.erase(entry);
+        m_treeChanged = true;
+    }
+    return true;
+}
+
+void
+CgroupCollector::removeGeometry()
+{
+    for (auto& entry : m_groups) {
+        entry.second->removeGeometry();
+    }
+}
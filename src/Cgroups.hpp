@@ -0,0 +1,136 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <cstdint>
+#include <glibmm.h>
+#include <NamedTreeNode2.hpp>
+
+#include "ProcReader.hpp"
+#include "ProcessHistory.hpp"
+
+class CgroupNode;
+
+typedef std::shared_ptr<CgroupNode> pCgroupNode;
+
+// the values of one cgroup (v2), the totals include the child groups
+class CgroupNode
+: public psc::gl::NamedTreeNode2
+{
+public:
+    CgroupNode(const Glib::ustring& name, const Glib::ustring& key, const pProcessHistory& history);
+    explicit CgroupNode(const CgroupNode& orig) = delete;
+    virtual ~CgroupNode();
+
+    float getLoad() override;
+    psc::gl::TreeNodeState getStage() override;
+    void setStage(psc::gl::TreeNodeState stage)
+    {
+        m_stage = stage;
+    }
+    void restart();
+    bool isTouched() const
+    {
+        return m_touched;
+    }
+    void setTouched(bool touched)
+    {
+        m_touched = touched;
+    }
+    // cpu ratio of all cpus 0..1
+    double getRawLoad() const
+    {
+        return m_load;
+    }
+    uint64_t getUsageUsec() const
+    {
+        return m_usageUsec;
+    }
+    uint64_t getMemoryBytes() const
+    {
+        return m_memoryBytes;
+    }
+    void addCpuData(Buffer<double>& buffer) const;
+    void addMemData(Buffer<double>& buffer) const;
+    // read the files of dirFd, elapsedUs since the last read
+    void read(int dirFd, ProcReader& reader, gint64 elapsedUs, double cpus, double memTotal);
+private:
+    bool readFile(int dirFd, const char* name, ProcReader& reader);
+
+    pProcessHistory m_history;
+    uint32_t m_historyIndex;
+    psc::gl::TreeNodeState m_stage;
+    bool m_touched;
+    uint64_t m_usageUsec;
+    uint64_t m_memoryBytes;
+    double m_load;
+    double m_memLoad;
+};
+
+// collects the cgroup (v2) hierarchy with a single walk of /sys/fs/cgroup,
+//   the per group totals are read from cpu.stat and memory.current
+//   (io.stat and cpu.pressure are not read, as long as there is no display for them)
+//   so the processes need not to be summed up.
+//   The groups are linked as tree so they can be displayed like the processes.
+class CgroupCollector
+{
+public:
+    CgroupCollector(uint32_t slots, const std::string& cgroupDir = CGROUP_DIR);
+    explicit CgroupCollector(const CgroupCollector& orig) = delete;
+    virtual ~CgroupCollector() = default;
+
+    // false if the cgroup dir is not readable (e.g. no cgroup v2)
+    bool update();
+    pCgroupNode getRoot() const
+    {
+        return m_root;
+    }
+    pCgroupNode find(const std::string& key) const;
+    size_t size() const
+    {
+        return m_groups.size();
+    }
+    bool isTreeChanged() const
+    {
+        return m_treeChanged;
+    }
+    void setTreeChanged(bool treeChanged)
+    {
+        m_treeChanged = treeChanged;
+    }
+    void removeGeometry();
+    static std::string unifiedDir(const std::string& cgroupDir);
+    static constexpr auto CGROUP_DIR = "/sys/fs/cgroup";
+private:
+    void walk(int dirFd, const pCgroupNode& parent, const std::string& key, gint64 elapsedUs);
+    pCgroupNode touch(const pCgroupNode& parent, const std::string& name, const std::string& key);
+
+    std::string m_cgroupDir;
+    pProcessHistory m_history;
+    ProcReader m_reader;
+    pCgroupNode m_root;
+    std::unordered_map<std::string, pCgroupNode> m_groups;
+    gint64 m_lastUpdate;
+    double m_cpus;
+    double m_memTotal;
+    bool m_treeChanged;
+};
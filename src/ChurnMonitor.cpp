@@ -0,0 +1,161 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <gtkmm.h>
+#include <glib/gi18n.h>
+#include <cmath>
+
+#include "ChurnMonitor.hpp"
+
+ChurnMonitor::ChurnMonitor(guint points, std::shared_ptr<LifecycleLog> lifecycle)
+: HistMonitor{points, "Churn"}
+, m_lifecycle{lifecycle}
+, m_lastForks{0u}
+, m_lastSpawns{0u}
+, m_lastExits{0u}
+, m_lastTime{0}
+, m_since{0u}
+{
+    m_enabled = false;          // disabled by default
+}
+
+ChurnMonitor::~ChurnMonitor()
+{
+}
+
+void
+ChurnMonitor::reinit()
+{
+    m_lastTime = 0;     // start over with the next update
+}
+
+Gtk::Box *
+ChurnMonitor::create_config_page(MonglView *monglView)
+{
+    auto churn_box = create_default_config_page(
+            _("Display process churn"),
+            _("Spawn color"),
+            _("Exit color"));
+
+    return churn_box;
+}
+
+gboolean
+ChurnMonitor::update(int refreshRate, glibtop * glibtop)
+{
+    // the events are logged by the process update that runs after the monitors,
+    //   so these lag one update behind the fork counter, the difference is
+    //   evened out by the next update (a negative difference is ignored)
+    uint64_t forks = LifecycleLog::readForks(m_reader);
+    uint64_t spawns = m_lifecycle->getSpawns();
+    uint64_t exits = m_lifecycle->getExits();
+    gint64 actual_time = g_get_monotonic_time();
+    if (m_lastTime != 0) {
+        gint64 delta_us = actual_time - m_lastTime;
+        if (delta_us <= 0) {
+            delta_us = static_cast<gint64>(refreshRate) * 1000l;
+        }
+        double perSecond = 1.0E6 / static_cast<double>(delta_us);
+        uint64_t seen = spawns - m_lastSpawns;
+        uint64_t forked = forks >= m_lastForks ? forks - m_lastForks : 0u;
+        uint64_t unseen = forked > seen ? forked - seen : 0u;     // lived shorter than an update
+        double spawnRate = static_cast<double>(seen + unseen) * perSecond;
+        double exitRate = static_cast<double>(exits - m_lastExits + unseen) * perSecond;
+        addPrimarySecondary(static_cast<guint64>(std::llround(spawnRate))
+                          , static_cast<guint64>(std::llround(exitRate)));
+    }
+    m_lastForks = forks;
+    m_lastSpawns = spawns;
+    m_lastExits = exits;
+    m_lastTime = actual_time;
+    findTopSpawner();
+    return TRUE;
+}
+
+// for a fork bomb or crash loop show who is at it
+void
+ChurnMonitor::findTopSpawner()
+{
+    m_events.clear();
+    m_since = m_lifecycle->read(m_since, m_events);
+    m_spawnsByName.clear();
+    uint32_t max = 0u;
+    for (auto& event : m_events) {
+        auto name = event.getName();
+        if (event.type == LifecycleEvent::Type::Spawn
+         && !name.empty()) {
+            uint32_t count = ++m_spawnsByName[name];
+            if (count > max) {
+                max = count;
+                m_topSpawner = name;
+            }
+        }
+    }
+    if (max == 0u) {
+        m_topSpawner.clear();
+    }
+}
+
+unsigned long
+ChurnMonitor::getTotal()
+{
+    return static_cast<unsigned long>(std::max(m_primaryHist.getMax(), m_secondaryHist.getMax()));
+}
+
+void
+ChurnMonitor::fillG15(G15Frame& frame)
+{
+    frame.lines.push_back("Churn");
+    frame.lines.push_back(getPrimMax());
+    frame.lines.push_back(getSecMax());
+    frame.framed = true;
+    for (guint i = 0; i < m_size; ++i) {
+        frame.values.push_back(std::max(getValues(0)->get(i), getValues(1)->get(i)));
+    }
+}
+
+void
+ChurnMonitor::load_settings(const Glib::KeyFile  * settings)
+{
+    config_setting_lookup_int(settings, m_name, CONFIG_DISPLAY_CHURN, &m_enabled);
+    if (!config_setting_lookup_color(settings, m_name, CONFIG_CHURN_COLOR, m_foreground_color))
+        m_foreground_color = Gdk::RGBA(CHURN_PRIMARY_DEFAULT_COLOR);
+
+    if (!config_setting_lookup_color(settings, m_name, CONFIG_CHURN_SECONDARY_COLOR, m_secondary_color))
+        m_secondary_color = Gdk::RGBA(CHURN_SECONDARY_DEFAULT_COLOR);
+}
+
+void
+ChurnMonitor::save_settings(Glib::KeyFile  * setting)
+{
+    config_group_set_int(setting, m_name, CONFIG_DISPLAY_CHURN, m_enabled);
+    config_group_set_color(setting, m_name, CONFIG_CHURN_COLOR, m_foreground_color);
+    config_group_set_color(setting, m_name, CONFIG_CHURN_SECONDARY_COLOR, m_secondary_color);
+}
+
+std::string
+ChurnMonitor::getPrimMax()
+{
+    return Glib::ustring::sprintf("%lu/s", getTotal());
+}
+
+std::string
+ChurnMonitor::getSecMax()
+{
+    return m_topSpawner.empty() ? std::string("spawn/exit") : m_topSpawner;
+}
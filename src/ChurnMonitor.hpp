@@ -0,0 +1,71 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "HistMonitor.hpp"
+#include "Lifecycle.hpp"
+
+// the rate of spawned (primary) and exited (secondary) processes per second.
+//   Processes that lived shorter than an update are not seen by the scan,
+//   these are taken from the fork counter of /proc/stat and count as spawn and exit
+//   (as the counter includes threads, so does the rate).
+class ChurnMonitor : public HistMonitor
+{
+public:
+    ChurnMonitor(guint points, std::shared_ptr<LifecycleLog> lifecycle);
+    virtual ~ChurnMonitor();
+
+    gboolean update(int refreshRate, glibtop * glibtop) override;
+
+    void load_settings(const Glib::KeyFile * setting) override;
+    void save_settings(Glib::KeyFile * setting) override;
+
+    Gtk::Box* create_config_page(MonglView *monglView) override;
+
+    void reinit() override;
+    unsigned long getTotal() override;
+    std::string getPrimMax() override;
+    std::string getSecMax() override;
+
+    void fillG15(G15Frame& frame) override;
+private:
+    void findTopSpawner();
+
+    std::shared_ptr<LifecycleLog> m_lifecycle;
+    ProcReader m_reader;
+    uint64_t m_lastForks;
+    uint64_t m_lastSpawns;
+    uint64_t m_lastExits;
+    gint64 m_lastTime;
+    uint64_t m_since;       // read position of the lifecycle
+    std::vector<LifecycleEvent> m_events;   // reused for each update
+    std::map<std::string_view, uint32_t> m_spawnsByName;    // views of m_events
+    std::string m_topSpawner;   // the name that spawned most in the last update
+    static constexpr auto CONFIG_DISPLAY_CHURN = "DisplayChurn";
+    static constexpr auto CONFIG_CHURN_COLOR = "ChurnColor";
+    static constexpr auto CONFIG_CHURN_SECONDARY_COLOR = "ChurnSecondaryColor";
+    static constexpr auto CHURN_PRIMARY_DEFAULT_COLOR = "#FFFF00";
+    static constexpr auto CHURN_SECONDARY_DEFAULT_COLOR = "#FF00FF";
+};
@@ -405,33 +405,15 @@ ClkMonitor::getColor(unsigned int diagram)
 
 
 void
-ClkMonitor::updateG15(Cairo::RefPtr<Cairo::Context> cr, guint width, guint height)
+ClkMonitor::fillG15(G15Frame& frame)
 {
-
     for (guint c = 0; c < MIN(cpus,4); ++c) {
-        cr->move_to(1.0, (c+1)*10);
         auto temp = Glib::ustring::sprintf("%.1fMHz", clkMHz[c]);
         if (c == 0) {
             temp += Glib::ustring::sprintf("  Cpus %d", cpus);
         }
-        cr->show_text(temp);
+        frame.lines.push_back(temp);
     }
-
-//    cr->rectangle(60.5, 0.5, width-61, height-1);
-//    cr->stroke();
-//    double x = width - 1.5;
-//    for (int i = m_size-1; i >= 0; --i)
-//    {
-//        cr->move_to(x, height-1);
-//        float y = (gfloat)(height-1) - m_primaryStats.get(i)*(gfloat)(height-2);
-//        cr->line_to(x, y);
-//        x -= 1.0;
-//        if (x <= 60.0) {
-//            break;
-//        }
-//    }
-//    cr->stroke();
-
 }
 
 void
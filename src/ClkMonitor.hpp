@@ -29,7 +29,7 @@ public:
 
     float readMaxFreq();
     gboolean update(int refreshRate, glibtop * glibtop) override;
-    void updateG15(Cairo::RefPtr<Cairo::Context> cr, guint width, guint height) override;
+    void fillG15(G15Frame& frame) override;
 
     void load_settings(const Glib::KeyFile * setting) override;
 
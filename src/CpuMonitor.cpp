@@ -46,6 +46,7 @@ CpuMonitor::CpuMonitor(guint points)
 , cpu_uns{0.0}
 , cpu_total{0.0}
 , m_cpu_total{0.0}
+, m_previousTime{0l}
 {
     m_enabled = TRUE;          // enabled by default
 }
@@ -73,6 +74,7 @@ gboolean
 CpuMonitor::update(int refreshRate, glibtop * glibtop)
 {
     struct cpu_stat cpu;
+    const double elapsed = elapsedSeconds(m_previousTime, refreshRate);
 #ifdef LIBGTOP
     glibtop_cpu gcpu;
     glibtop_get_cpu_l(glibtop, &gcpu);
@@ -104,7 +106,7 @@ CpuMonitor::update(int refreshRate, glibtop * glibtop)
         getValues(0)->set(cpu_un / cpu_total);       // use only user here as we show process below that
         getValues(1)->set(cpu_uns / cpu_total);      // stack sys value as it is not related to process times
 
-        m_cpu_total = cpu_total / (double)((refreshRate > 0) ? refreshRate : 1);    // show per second
+        m_cpu_total = cpu_total / elapsed;    // show per second
     }
 #else
 
@@ -164,7 +166,7 @@ CpuMonitor::update(int refreshRate, glibtop * glibtop)
         r_user = (cpu_un / cpu_total);       // use only user here as we show process below that
         r_system = (cpu_uns / cpu_total);      // stack sys value as it is not related to process times
 
-        m_cpu_total = cpu_total / (double)((refreshRate > 0) ? refreshRate : 1);    // show per second
+        m_cpu_total = cpu_total / elapsed;    // show per second
     }
     getValues(0)->set(r_user);              // push value even if empty
     getValues(1)->set(r_system);
@@ -173,31 +175,14 @@ CpuMonitor::update(int refreshRate, glibtop * glibtop)
 }
 
 void
-CpuMonitor::updateG15(Cairo::RefPtr<Cairo::Context> cr, guint width, guint height)
+CpuMonitor::fillG15(G15Frame& frame)
 {
-    char temp[64];
-
-    cr->move_to(1.0, 10.0);
-    cr->show_text("Cpu");
-    sprintf(temp, "%.1f%%", cpu_uns / cpu_total * 100.0f);
-    cr->move_to(1.0, 20.0);
-    cr->show_text(temp);
-
-    cr->rectangle(60.5, 0.5, width-61, height-1);
-    cr->stroke();
-    double x = width - 1.5;
-    for (int i = m_size-1; i >= 0; --i)
-    {
-        cr->move_to(x, height-1);
-        float y = (gfloat)(height-1) - getValues(0)->get(i)*(gfloat)(height-2);
-        cr->line_to(x, y);
-        x -= 1.0;
-        if (x <= 60.0) {
-            break;
-        }
+    frame.lines.push_back("Cpu");
+    frame.lines.push_back(Glib::ustring::sprintf("%.1f%%", cpu_uns / cpu_total * 100.0f));
+    frame.framed = true;
+    for (guint i = 0; i < m_size; ++i) {
+        frame.values.push_back(getValues(0)->get(i));
     }
-    cr->stroke();
-
 }
 
 void
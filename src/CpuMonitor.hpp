@@ -28,7 +28,7 @@ public:
 
 
     gboolean update(int refreshRate, glibtop * glibtop) override;
-    void updateG15(Cairo::RefPtr<Cairo::Context> cr, guint width, guint height) override;
+    void fillG15(G15Frame& frame) override;
 
     void load_settings(const Glib::KeyFile * setting) override;
 
@@ -44,6 +44,7 @@ private:
     double cpu_uns;
     double cpu_total;
     double m_cpu_total;
+    gint64 m_previousTime;
 
     static constexpr auto CPU_PRIMARY_DEFAULT_COLOR = "#0000FF";
     static constexpr auto CPU_SECONDARY_DEFAULT_COLOR = "#00FF00";
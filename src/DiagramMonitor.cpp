@@ -26,6 +26,7 @@
 DiagramMonitor::DiagramMonitor(std::shared_ptr<Monitor> _monitor, NaviContext *_naviContext, TextContext *_textCtx)
 : Diagram2{_monitor->getSize(), _naviContext, _textCtx}
 , m_monitor{_monitor}
+, m_axis{std::make_shared<Buffer<double>>(_monitor->getSize())}
 {
     for (guint i = 0; i < m_monitor->getNumDiagram(); ++i) {
 		auto val = m_monitor->getValues(i);
@@ -36,16 +37,104 @@ DiagramMonitor::DiagramMonitor(std::shared_ptr<Monitor> _monitor, NaviContext *_
 
 
 void
-DiagramMonitor::update(gint updateInterval, glibtop *glibtop)
+DiagramMonitor::sample(gint updateInterval, glibtop *glibtop)
 {
-    m_monitor->roll();
-    m_monitor->update(updateInterval, glibtop);
-    for (guint i = 0; i < m_monitor->getNumDiagram(); ++i) {
-        fill_buffers(i, m_monitor->getValues(i), m_monitor->getColor(i));
+    if (!m_monitor->isGlBound()) {
+        m_monitor->roll();
+        m_monitor->update(updateInterval, glibtop);
+    }
+}
+
+void
+DiagramMonitor::present(gint updateInterval, glibtop *glibtop)
+{
+    if (m_due) {
+        m_phase = 0u;
+        if (m_monitor->isGlBound()) {
+            m_monitor->roll();
+            m_monitor->update(updateInterval, glibtop);
+        }
+    }
+    else {
+        ++m_phase;
+    }
+    if (m_due
+     || (m_updateTicks > 1u && m_tier == TierHistory::RAW)) {  // otherwise nothing moved
+        m_refill = true;
+    }
+    refill();
+    if (!m_due) {
+        return;
     }
     const Glib::ustring pmax(m_monitor->getPrimMax());
     const Glib::ustring smax(m_monitor->getSecMax());
     setMaxs(pmax, smax);
+#ifdef LIBG15
+    m_monitor->publishG15();    // the worker draws from this copy
+#endif
+}
+
+void
+DiagramMonitor::refill()
+{
+    if (m_refill) {
+        m_refill = false;
+        for (guint i = 0; i < m_monitor->getNumDiagram(); ++i) {
+            fill_series(i);
+        }
+    }
+}
+
+void
+DiagramMonitor::fill_series(guint idx)
+{
+    if (m_tier == TierHistory::RAW) {
+        fill_values(idx, m_monitor->getValues(idx), m_monitor->getColor(idx));
+    }
+    else {
+        m_monitor->getValues(idx, m_tier, TierHistory::AVG, *m_axis);
+        fill_buffers(idx, m_axis, m_monitor->getColor(idx));
+    }
+}
+
+void
+DiagramMonitor::fill_values(guint idx, const std::shared_ptr<Buffer<double>>& values, Gdk::RGBA *color)
+{
+    fill_values(idx, values, color, m_updateTicks, m_phase);
+}
+
+void
+DiagramMonitor::fill_values(guint idx, const std::shared_ptr<Buffer<double>>& values, Gdk::RGBA *color, const DiagramMonitor& source)
+{
+    fill_values(idx, values, color, source.getUpdateTicks(), source.getPhase());
+}
+
+// each sample is held until the next one,
+//   so graphs with different cadences share the time axis
+void
+DiagramMonitor::fill_values(guint idx, const std::shared_ptr<Buffer<double>>& values, Gdk::RGBA *color, uint32_t updateTicks, uint32_t phase)
+{
+    const uint32_t size = m_monitor->getSize();
+    if (m_tier != TierHistory::RAW) {   // values on the update axis, collapse these
+        for (uint32_t i = 0; i < size; ++i) {
+            m_axis->set(i, 0.0);
+        }
+        m_axis->refreshSum();
+        fill_buffers(idx, m_axis, color);
+        return;
+    }
+    if (updateTicks <= 1u
+     || !values) {
+        fill_buffers(idx, values, color);
+        return;
+    }
+    for (uint32_t i = 0; i < size; ++i) {
+        const uint32_t age = size - 1u - i;     // ticks before now
+        const uint32_t sampleAge = age <= phase ? 0u : (age - phase + updateTicks - 1u) / updateTicks;
+        m_axis->set(i, sampleAge < size ? values->get(size - 1u - sampleAge) : 0.0);
+    }
+    m_axis->refreshSum();
+    fill_buffers(idx, m_axis, color);     // copies the values
 }
 
 void
@@ -31,7 +31,15 @@ public:
     DiagramMonitor(std::shared_ptr<Monitor> _monitor, NaviContext *_naviContext, TextContext *_textCtx);
     virtual ~DiagramMonitor() = default;
 
-    void update(gint updateInterval, glibtop *glibtop);
+    // collect the values, called by the sampler thread (the monitors using gl are skipped)
+    void sample(gint updateInterval, glibtop *glibtop);
+    // show the collected values, called with the gl context on every tick
+    //   (if not due the graph only moves along the time axis)
+    void present(gint updateInterval, glibtop *glibtop);
+    // show values sampled at the cadence of this diagram on the common time axis (one point per tick)
+    void fill_values(guint idx, const std::shared_ptr<Buffer<double>>& values, Gdk::RGBA *color);
+    // same for values sampled at the cadence of source e.g. the processes that follow the cpu
+    void fill_values(guint idx, const std::shared_ptr<Buffer<double>>& values, Gdk::RGBA *color, const DiagramMonitor& source);
     void save_settings(Glib::KeyFile *keyFile);
     Gtk::Box* create_config_page(MonglView *monglView);
     void close();
@@ -39,7 +47,45 @@ public:
     std::shared_ptr<Monitor> getMonitor() {
         return m_monitor;
     }
+    // sample on every n-th tick of the scheduler
+    void setUpdateTicks(uint32_t updateTicks) {
+        m_updateTicks = updateTicks;
+    }
+    uint32_t getUpdateTicks() const {
+        return m_updateTicks;
+    }
+    // set by the gui before the sample is requested
+    void setDue(bool due) {
+        m_due = due;
+    }
+    bool isDue() const {
+        return m_due;
+    }
+    // ticks since the last sample
+    uint32_t getPhase() const {
+        return m_phase;
+    }
+    // zoom the time axis, shown with the next present or refill
+    //   (the processes have no tiers, their graphs are hidden for these)
+    void setTier(TierHistory::Tier tier) {
+        m_tier = tier;
+        m_refill = true;
+    }
+    TierHistory::Tier getTier() const {
+        return m_tier;
+    }
+    // show the values again if required, called with the gl context while not sampling
+    void refill();
 private:
+    void fill_series(guint idx);
+    void fill_values(guint idx, const std::shared_ptr<Buffer<double>>& values, Gdk::RGBA *color, uint32_t updateTicks, uint32_t phase);
+
     std::shared_ptr<Monitor> m_monitor;
+    uint32_t m_updateTicks{1u};
+    bool m_due{true};
+    uint32_t m_phase{0u};
+    TierHistory::Tier m_tier{TierHistory::RAW};
+    bool m_refill{false};
+    std::shared_ptr<Buffer<double>> m_axis;    // the values spread to the ticks
 };
 
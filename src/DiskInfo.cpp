@@ -197,7 +197,7 @@ DiskInfo::reinit()
 }
 
 bool
-DiskInfo::readStat(char const *line, gint64 delta_us)
+DiskInfo::readStat(char const *line, gint64 now_us)
 {
     struct disk_stat tdisk;
     char tdev[80];
@@ -219,6 +219,7 @@ DiskInfo::readStat(char const *line, gint64 delta_us)
         disk_delta.weightime = tdisk.weightime - previous_disk_stat.weightime;
         unsigned long writeValue = disk_delta.wsect;
         unsigned long readValue = disk_delta.rsect;
+        gint64 delta_us = m_previousTime > 0l ? now_us - m_previousTime : 0l;
         if (delta_us > 0l) {    // for the first call time will not be valid and values will jump from 0 to all
             // only update after init
             double delta_sect_s = 512.0E6/(double)delta_us;        // factor that combines conversion sectors per time unit to byte/s
@@ -236,6 +237,8 @@ DiskInfo::readStat(char const *line, gint64 delta_us)
         }
         /* Copy current to previous. */
         previous_disk_stat = tdisk;
+        m_previousTime = now_us;
+        m_deltaUs = delta_us;
         m_actualReadTime = disk_delta.rtime;
         m_actualWriteTime = disk_delta.wtime;
         return true;
@@ -244,11 +247,11 @@ DiskInfo::readStat(char const *line, gint64 delta_us)
 }
 
 bool
-DiskInfo::isChanged(gint updateInterval)
+DiskInfo::isChanged()
 {
     auto diffRead = std::abs((gint64)m_lastReadTime - (gint64)getActualReadTime());
     auto diffWrite = std::abs((gint64)m_lastWriteTime - (gint64)getActualWriteTime());
-    long ioThreshold = updateInterval * 10;  // interval is seconds  (io is ms ) -> *1000, want percent -> /100  = *10
+    long ioThreshold = static_cast<long>(m_deltaUs / 100000l);  // interval is us (io is ms) -> /1000, want percent -> /100
     if (diffRead > ioThreshold
      || diffWrite > ioThreshold) {  // 1% of io time
         return true;
@@ -263,13 +266,14 @@ DiskInfo::getTotalRWSectors()
 }
 
 void
-DiskInfo::getDiskStats(std::map<std::string, PtrDiskInfo>& map, int64_t diff_us)
+DiskInfo::getDiskStats(std::map<std::string, PtrDiskInfo>& map)
 {
     FileByLine fileByLine;
     if (!fileByLine.open("/proc/diskstats", "r")) {
         std::cout << "DiskInfos: Could not open /proc/diskstats: " << errno << " " << strerror(errno) << std::endl;
         return;
     }
+    gint64 now_us = g_get_monotonic_time();    // the promise is this does not get screwed up by time adjustments
     size_t len{};
     std::set<std::string> foundDev;
     while (true) {
@@ -289,7 +293,7 @@ DiskInfo::getDiskStats(std::map<std::string, PtrDiskInfo>& map, int64_t diff_us)
                 else {
                     pInfo = dev->second;
                 }
-                pInfo->readStat(line, diff_us);
+                pInfo->readStat(line, now_us);
                 foundDev.insert(tInfo.getDevice());
             }
         }
@@ -105,7 +105,8 @@ public:
     DiskInfo();
     virtual ~DiskInfo() = default;
 
-    bool readStat(char const *line, gint64 delta_us);
+    // the rates use the time since the previous read of this device (now 0 only parses)
+    bool readStat(char const *line, gint64 now_us);
 
     std::string getDevice() const {
         return m_device;
@@ -129,12 +130,14 @@ public:
     void setLastWriteTime(unsigned long lastWriteTime) {
         m_lastWriteTime = lastWriteTime;
     }
-    bool isChanged(gint updateInterval);
+    bool isChanged();
     guint64 getTotalRWSectors();
     void reinit();
-    static void getDiskStats(std::map<std::string, PtrDiskInfo>& map, int64_t diff_us);
+    static void getDiskStats(std::map<std::string, PtrDiskInfo>& map);
 private:
     struct disk_stat previous_disk_stat;
+    gint64 m_previousTime{};    // us monotonic
+    gint64 m_deltaUs{};
     std::string m_device;
     guint64 m_bytesReadPerS;
     guint64 m_bytesWrittenPerS;
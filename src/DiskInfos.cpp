@@ -72,7 +72,6 @@ DiskGeom::getGeometry() const
 
 DiskInfos::DiskInfos()
 : Infos()
-, m_previous_diskstat_time{}
 {
 }
 
@@ -93,24 +92,7 @@ void DiskInfos::update(int refreshRate, glibtop * glibtop)
 void
 DiskInfos::updateDiskStat(int refreshRate, glibtop * glibtop)
 {
-    gint64 actual_time = g_get_monotonic_time();    // the promise is this does not get screwed up by time adjustments
-    gint64 diff_us{};
-    if (m_previous_diskstat_time > 0l) {
-        diff_us = actual_time - m_previous_diskstat_time;
-    }
-    DiskInfo::getDiskStats(m_devices, diff_us);
-    m_previous_diskstat_time = actual_time;
-    // remove geom we don't have a device for
-    for (auto iterGeom = m_geom.begin(); iterGeom != m_geom.end(); ) {
-        auto diskGeom = iterGeom->second;
-        if (m_devices.find(iterGeom->first) == m_devices.end()) {
-            //std::cout << "Remove device not touched " << iterGeom->first << std::endl;
-            iterGeom = m_geom.erase(iterGeom);
-        }
-        else {
-            ++iterGeom;
-        }
-    }
+    DiskInfo::getDiskStats(m_devices);   // each device keeps its own read time
 }
 
 // get from device name of a partition the disk e.g. sda1 -> sda
@@ -187,23 +169,33 @@ DiskInfos::updateMounts(int refresh_rate, glibtop * glibtop)
         }
     }
 #endif
-    std::set<std::string> touchedDevices;
     for (auto imap = m_mounts.begin(); imap != m_mounts.end(); ) {
         auto& filesys = imap->second;
         if (!filesys->isFilesysTouched()) {    // if device is unmounted keep device, but remove from display
             imap = m_mounts.erase(imap);
         }
         else {
-            //std::cout << "Collecting dev " << filesys->getDevName() << std::endl;
-            touchedDevices.insert(filesys->getDevName());
             ++imap;
         }
     }
-    for (auto dev : m_geom) {
-        if (!touchedDevices.contains(dev.first)) {  // since we have no association to filesys don't show device
-            auto& diskGeo = dev.second;
-            //std::cout << "DiskInfos::updateMounts removing devGeo first " << dev.first << " dev " << dev.first << std::endl;
-            diskGeo->removeGeometry();
+}
+
+void
+DiskInfos::updateGeometries()
+{
+    std::set<std::string> touchedDevices;
+    for (auto& p : m_mounts) {
+        touchedDevices.insert(p.second->getDevName());
+    }
+    for (auto iterGeom = m_geom.begin(); iterGeom != m_geom.end(); ) {
+        if (m_devices.find(iterGeom->first) == m_devices.end()) {  // remove geom we don't have a device for
+            iterGeom = m_geom.erase(iterGeom);
+        }
+        else {
+            if (!touchedDevices.contains(iterGeom->first)) {  // since we have no association to filesys don't show device
+                iterGeom->second->removeGeometry();
+            }
+            ++iterGeom;
         }
     }
 }
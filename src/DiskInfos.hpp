@@ -70,7 +70,11 @@ public:
     virtual ~DiskInfos();
 
     void update(int refreshRate, glibtop * glibtop) override;
-    bool updateDiskStat(gint64 diff);
+    // adjust the geometries to the devices and mounts found by update, needs the gl context
+    void updateGeometries();
+    // the parts of update, to allow reading the stats at a different rate than the mounts
+    void updateDiskStat(int refreshRate, glibtop * glibtop);
+    void updateMounts(int refresh_rate, glibtop * glibtop);
     PtrDiskInfo getPrefered(std::string const &device) const;
     // get from device name of a partition the disk e.g. sda1 -> sda
     PtrDiskInfo getDisk(std::string const &device) const;
@@ -82,11 +86,6 @@ public:
     void removeDiskInfos();
     PtrDiskGeom createGeometry(const std::string& dev);
 private:
-    void updateDiskStat(int refreshRate, glibtop * glibtop);
-    void updateMounts(int refresh_rate, glibtop * glibtop);
-
-    gint64 m_previous_diskstat_time;
-
     std::map<std::string, PtrDiskInfo> m_devices;   // key is device e.g. sda1
     std::map<std::string, PtrDiskGeom> m_geom;      // key is device e.g. sda1
     std::map<std::string, PtrMountInfo> m_mounts;   // key is mount point e.g. /home
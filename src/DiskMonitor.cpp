@@ -27,6 +27,7 @@
 #include "G15Worker.hpp"
 #include "DiskMonitor.hpp"
 #include "DiskInfos.hpp"
+#include "MonglView.hpp"
 
 DiskMonitor::DiskMonitor(guint points)
 : HistMonitor{points, "DISK"}
@@ -42,11 +43,13 @@ DiskMonitor::reinit()
 
 
 void
-DiskMonitor::disk_device_changed(Gtk::ComboBox *device_combo)
+DiskMonitor::disk_device_changed(Gtk::ComboBox *device_combo, MonglView *monglView)
 {
-    m_device = device_combo->get_active_id();
-
-    reinit();
+    Glib::ustring device = device_combo->get_active_id();
+    monglView->changeCollectors([this, device] {
+        m_device = device;
+        reinit();
+    });
 }
 
 
@@ -83,9 +86,9 @@ DiskMonitor::create_config_page(MonglView *monglView)
     }
     combo->set_active_id(m_device);
     combo->signal_changed().connect(
-                    sigc::bind<Gtk::ComboBox *>(
+                    sigc::bind<Gtk::ComboBox *, MonglView *>(
                     sigc::mem_fun(*this, &DiskMonitor::disk_device_changed),
-                    combo));
+                    combo, monglView));
     add_widget2box(disk_box, _("Device (.e.g sda)"), combo, 0.0f);
 
     //auto device_entry = Gtk::manage(new Gtk::Entry());
@@ -121,32 +124,17 @@ DiskMonitor::getTotal()
 }
 
 void
-DiskMonitor::updateG15(Cairo::RefPtr<Cairo::Context> cr, guint width, guint height)
+DiskMonitor::fillG15(G15Frame& frame)
 {
     float fmax = MAX(m_primaryHist.getMax(), m_secondaryHist.getMax());
 
-    cr->move_to(1.0, 10.0);
-    cr->show_text("Dsk");
-    cr->move_to(1.0, 20.0);
-    cr->show_text(m_used_device);
-    cr->move_to(1.0, 30.0);
-    std::string total = formatScale(fmax, "B/s");
-    cr->show_text(total);
-
-    cr->rectangle(60.5, 0.5, width-61, height-1);
-    cr->stroke();
-    double x = width - 1.5;
-    for (int i = m_size-1; i >= 0; --i)
-    {
-        cr->move_to(x, height-1);
-        float y = (float)(height-1) - (MAX(m_primaryHist.get(i), m_secondaryHist.get(i))/fmax)*(gfloat)(height-2);
-        cr->line_to(x, y);
-        x -= 1.0;
-        if (x <= 60.0) {
-            break;
-        }
+    frame.lines.push_back("Dsk");
+    frame.lines.push_back(m_used_device);
+    frame.lines.push_back(formatScale(fmax, "B/s"));
+    frame.framed = true;
+    for (guint i = 0; i < m_size; ++i) {
+        frame.values.push_back(MAX(m_primaryHist.get(i), m_secondaryHist.get(i))/fmax);
     }
-    cr->stroke();
 }
 
 void
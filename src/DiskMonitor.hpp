@@ -29,7 +29,10 @@ public:
     virtual ~DiskMonitor() = default;
 
     gboolean update(int refreshRate, glibtop * glibtop) override;
-    void updateG15(Cairo::RefPtr<Cairo::Context> cr, guint width, guint height) override;
+    bool isDiskStatBound() const override {
+        return true;
+    }
+    void fillG15(G15Frame& frame) override;
 
     void load_settings(const Glib::KeyFile * setting) override;
 
@@ -44,7 +47,7 @@ public:
 
     void setDiskInfos(const std::shared_ptr<DiskInfos>& diskInfos);
 private:
-    void disk_device_changed(Gtk::ComboBox *device_combo);
+    void disk_device_changed(Gtk::ComboBox *device_combo, MonglView *monglView);
     std::shared_ptr<DiskInfos> m_diskInfos;
     static constexpr auto DISK_PRIMARY_DEFAULT_COLOR = "#00FF00";
     static constexpr auto DISK_SECONDARY_DEFAULT_COLOR = "#FF0000";
@@ -79,7 +79,7 @@ Filesyses::update(
             for (auto mntInfo : mntInfos) {
                 update |= mntInfo->isChanged();
             }
-            if (update||devInfo->isChanged(updateInterval)) {
+            if (update||devInfo->isChanged()) {
                 updateDiskGeometry(geo, diskGeom, devInfo, mntInfos, pGraph_shaderContext, textCtx, pFont, persView, updateInterval);
             }
             if (geo) {
@@ -94,19 +94,13 @@ Filesyses::update(
 }
 
 void
-Filesyses::updateG15(Cairo::RefPtr<Cairo::Context> cr, guint width, guint height)
+Filesyses::fillG15(G15Frame& frame)
 {
-    double y = 10.0;
     for (auto p : m_diskInfos->getFilesyses()) {
         auto filesys = p.second;
-        cr->move_to(1.0, y);
         float percent = filesys->getFreePercent();
         std::string size = Monitor::formatScale(filesys->getCapacityBytes(), "");
-        auto tmp = psc::fmt::format("{:10} {:7} {:4.1f}%", filesys->getMount(), size, percent);
-        cr->show_text(tmp);
-        y += 10;
-        if (y > height)
-            break;
+        frame.lines.push_back(psc::fmt::format("{:10} {:7} {:4.1f}%", filesys->getMount(), size, percent));
     }
 }
 
@@ -44,7 +44,7 @@ public:
         , Matrix &persView
         , gint updateInterval);
 
-    void updateG15(Cairo::RefPtr<Cairo::Context> cr, guint width, guint height) override;
+    void fillG15(G15Frame& frame) override;
     void setDiskInfos(const std::shared_ptr<DiskInfos>& diskInfos);
 protected:
     void updateDiskGeometry(
@@ -166,7 +166,7 @@ GpuMonitor::update(int refreshRate, glibtop * glibtop)
 		amdCounters->read();
 #endif
 		gint64 actual_time = g_get_monotonic_time();    // the promise is this does not get screwed up by time adjustments
-		guint64 dt = refreshRate * 1e6l;
+		guint64 dt = refreshRate * 1e3l;
 		if (previous_time != 0) {
 			dt = (actual_time - previous_time);
 		}
@@ -201,42 +201,9 @@ GpuMonitor::getTotal()
 }
 
 void
-GpuMonitor::updateG15(Cairo::RefPtr<Cairo::Context> cr, guint width, guint height)
+GpuMonitor::fillG15(G15Frame& frame)
 {
-//    guint64 maxPrim = m_primaryHist.getMax();
-//    float fPrim = maxPrim;
-//    guint64 maxSec = m_secondaryHist.getMax();
-//    float fSec = maxSec;
-//
-//    cr->move_to(1.0, 10.0);
-//    cr->show_text("GPU");
-//    cr->move_to(1.0, 20.0);
-//    cr->show_text("P");
-//    cr->move_to(10.0, 20.0);
-//    std::string total = formatScale(fPrim, "");
-//    cr->show_text(total);
-//    cr->move_to(1.0, 30.0);
-//    cr->show_text("S");
-//    cr->move_to(10.0, 30.0);
-//    total = formatScale(fSec, "");
-//    cr->show_text(total);
-//
-//
-    cr->rectangle(60.5, 0.5, width-61, height-1);
-    cr->stroke();
-//    double x = width - 1.5;
-//    for (int i = m_size-1; i >= 0; --i)
-//    {
-//        cr->move_to(x, height-1);
-//        float y = (float)(height-1) - (m_secondaryHist.get(i)/fSec)*(gfloat)(height-2);
-//        cr->line_to(x, y);
-//        x -= 1.0;
-//        if (x <= 60.0) {
-//            break;
-//        }
-//    }
-//    cr->stroke();
-
+    frame.framed = true;    // the values are not shown yet
 }
 
 std::list<std::string>
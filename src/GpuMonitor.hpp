@@ -32,7 +32,10 @@ public:
 
     virtual void close() override;
     gboolean update(int refreshRate, glibtop * glibtop) override;
-    void updateG15(Cairo::RefPtr<Cairo::Context> cr, guint width, guint height) override;
+    bool isGlBound() const override {
+        return true;    // uses gl queries
+    }
+    void fillG15(G15Frame& frame) override;
 
     void load_settings(const Glib::KeyFile * setting) override;
 
@@ -37,18 +37,60 @@ HistMonitor::~HistMonitor() {
 
 void
 HistMonitor::roll() {
-    getValues(0)->roll();      // These two are not strictly required
-    getValues(1)->roll();
+    Monitor::roll();
     m_primaryHist.roll();
     m_secondaryHist.roll();
 }
 
+void
+HistMonitor::consolidate(gint64 sampleUs)
+{
+    record(0, static_cast<double>(m_primaryHist.get(m_size - 1u)), sampleUs);
+    record(1, static_cast<double>(m_secondaryHist.get(m_size - 1u)), sampleUs);
+}
+
+void
+HistMonitor::restore(unsigned int diagram, const HistoryRegion& region)
+{
+    if (diagram > 1u) {
+        Monitor::restore(diagram, region);
+        return;
+    }
+    auto& hist = diagram == 0u ? m_primaryHist : m_secondaryHist;
+    for (guint i = 0; i < m_size; ++i) {
+        hist.set(i, static_cast<guint64>(region.get(i)));
+    }
+    hist.refreshSum();
+    rescale();
+}
+
+void
+HistMonitor::getValues(unsigned int diagram, TierHistory::Tier tier, TierHistory::Stat stat, Buffer<double>& buffer)
+{
+    if (tier == TierHistory::RAW
+     || diagram > 1u) {
+        Monitor::getValues(diagram, tier, stat, buffer);
+        return;
+    }
+    double max = std::max(getTiers(0).getMax(tier), getTiers(1).getMax(tier));
+    getTiers(diagram).fill(tier, stat, buffer, max > 0.0 ? 1.0 / max : 0.0);
+}
+
 void
 HistMonitor::addPrimarySecondary(guint64 primaryValue, guint64 secondaryValue)
 {
     m_primaryHist.set(primaryValue);
     m_secondaryHist.set(secondaryValue);
+    rescale();
+}
+
+void
+HistMonitor::rescale()
+{
     guint64 max = std::max(m_primaryHist.getMax(), m_secondaryHist.getMax());
+    if (max == 0u) {
+        max = 1u;   // e.g. restored without values
+    }
     for (guint i = 0; i < m_size; i++)
     {
         getValues(0)->set(i, m_primaryHist.get(i) / (double)max);
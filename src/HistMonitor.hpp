@@ -29,11 +29,17 @@ public:
 
     void roll() override;
     void addPrimarySecondary(guint64 primaryValue, guint64 secondaryValue);
+    // scaled like the values by the maximum of both
+    void getValues(unsigned int diagram, TierHistory::Tier tier, TierHistory::Stat stat, Buffer<double>& buffer) override;
+    using Monitor::getValues;
 
 protected:
+    // the values are scaled by the actual maximum, so keep the absolute
+    void consolidate(gint64 sampleUs) override;
+    void restore(unsigned int diagram, const HistoryRegion& region) override;
     Buffer<guint64> m_primaryHist;
     Buffer<guint64> m_secondaryHist;
 private:
-
+    void rescale();
 };
 
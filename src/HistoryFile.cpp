@@ -0,0 +1,215 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/file.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <cerrno>
+#include <cstring>
+#include <new>
+#include <algorithm>
+#include <Log.hpp>
+
+#include "HistoryFile.hpp"
+
+HistoryRegion::HistoryRegion(Header* header, uint32_t points)
+: m_header{header}
+, m_raw{reinterpret_cast<double*>(header + 1)}
+, m_tiers{reinterpret_cast<float*>(m_raw + points)}
+, m_points{points}
+{
+}
+
+void
+HistoryRegion::push(double value)
+{
+    uint32_t head = m_header->head.load(std::memory_order_relaxed);
+    head = head + 1u < m_points ? head + 1u : 0u;
+    m_raw[head] = value;
+    m_header->head.store(head, std::memory_order_release);
+}
+
+double
+HistoryRegion::get(uint32_t i) const
+{
+    uint32_t slot = m_header->head.load(std::memory_order_acquire) + 1u + i;
+    while (slot >= m_points) {
+        slot -= m_points;
+    }
+    return m_raw[slot];
+}
+
+HistoryFile::HistoryFile(uint32_t points)
+: m_points{std::max(points, 1u)}
+, m_fd{-1}
+, m_map{MAP_FAILED}
+, m_header{nullptr}
+{
+}
+
+HistoryFile::~HistoryFile()
+{
+    close();
+}
+
+std::string
+HistoryFile::getDefaultPath()
+{
+    const char* state = g_getenv("XDG_STATE_HOME");
+    std::string dir = state != nullptr && *state != '\0'
+                    ? std::string(state)
+                    : Glib::build_filename(Glib::get_home_dir(), ".local", "state");
+    return Glib::build_filename(dir, "monglmm", "history.map");
+}
+
+size_t
+HistoryFile::getRegionSize() const
+{
+    size_t size = sizeof(HistoryRegion::Header)
+                + sizeof(double) * m_points
+                + sizeof(float) * TierHistory::getValueCount(m_points);
+    return (size + 7u) & ~static_cast<size_t>(7u);    // keep the next header aligned
+}
+
+size_t
+HistoryFile::getFileSize() const
+{
+    return sizeof(Header) + getRegionSize() * REGIONS;
+}
+
+bool
+HistoryFile::open(const std::string& path)
+{
+    close();
+    auto dir = Glib::path_get_dirname(path);
+    if (g_mkdir_with_parents(dir.c_str(), 0700) != 0) {
+        psc::log::Log::logAdd(psc::log::Level::Warn, Glib::ustring::sprintf("History could not create %s %s", dir, strerror(errno)));
+        return false;
+    }
+    m_fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_CLOEXEC, 0600);
+    if (m_fd < 0) {
+        psc::log::Log::logAdd(psc::log::Level::Warn, Glib::ustring::sprintf("History could not open %s %s", path, strerror(errno)));
+        return false;
+    }
+    if (flock(m_fd, LOCK_EX | LOCK_NB) != 0) {     // two writers would mix up the heads
+        psc::log::Log::logAdd(psc::log::Level::Warn, Glib::ustring::sprintf("History %s is used by a other instance", path));
+        close();
+        return false;
+    }
+    struct stat st;
+    bool fits = fstat(m_fd, &st) == 0
+             && static_cast<size_t>(st.st_size) == getFileSize();
+    if (!fits
+     && ftruncate(m_fd, static_cast<off_t>(getFileSize())) != 0) {
+        psc::log::Log::logAdd(psc::log::Level::Warn, Glib::ustring::sprintf("History could not size %s %s", path, strerror(errno)));
+        close();
+        return false;
+    }
+    m_map = mmap(nullptr, getFileSize(), PROT_READ | PROT_WRITE, MAP_SHARED, m_fd, 0);
+    if (m_map == MAP_FAILED) {
+        psc::log::Log::logAdd(psc::log::Level::Warn, Glib::ustring::sprintf("History could not map %s %s", path, strerror(errno)));
+        close();
+        return false;
+    }
+    m_header = static_cast<Header*>(m_map);
+    if (!fits
+     || !isValid()) {
+        create();
+    }
+    return true;
+}
+
+bool
+HistoryFile::isValid() const
+{
+    return memcmp(m_header->magic, MAGIC, sizeof(MAGIC)) == 0
+        && m_header->version == VERSION
+        && m_header->points == m_points
+        && m_header->regions == REGIONS
+        && m_header->regionSize == getRegionSize()
+        && m_header->used.load() <= REGIONS;
+}
+
+// start empty, as a previous layout may be left
+void
+HistoryFile::create()
+{
+    memset(m_map, 0, getFileSize());
+    new (m_header) Header();
+    m_header->version = VERSION;
+    m_header->points = m_points;
+    m_header->regions = REGIONS;
+    m_header->regionSize = static_cast<uint32_t>(getRegionSize());
+    m_header->used.store(0u);
+    memcpy(m_header->magic, MAGIC, sizeof(MAGIC));   // last, so a interrupted create is not valid
+    msync(m_map, getFileSize(), MS_SYNC);
+}
+
+HistoryRegion
+HistoryFile::getRegion(const std::string& name, bool create)
+{
+    if (m_header == nullptr) {
+        return HistoryRegion();
+    }
+    std::lock_guard<std::mutex> lock(m_mutex);
+    auto base = static_cast<char*>(m_map) + sizeof(Header);
+    const uint32_t used = m_header->used.load(std::memory_order_acquire);
+    for (uint32_t r = 0; r < used; ++r) {
+        auto header = reinterpret_cast<HistoryRegion::Header*>(base + getRegionSize() * r);
+        if (strncmp(header->name, name.c_str(), sizeof(header->name)) == 0) {
+            return HistoryRegion(header, m_points);
+        }
+    }
+    if (!create
+     || used >= REGIONS
+     || name.size() >= sizeof(HistoryRegion::Header::name)) {
+        return HistoryRegion();
+    }
+    auto header = new (base + getRegionSize() * used) HistoryRegion::Header();
+    strncpy(header->name, name.c_str(), sizeof(header->name) - 1u);
+    header->head.store(m_points - 1u);
+    HistoryRegion region(header, m_points);
+    TierHistory::clear(region.getTierState(), region.getTierValues(), m_points);
+    m_header->used.store(used + 1u, std::memory_order_release);
+    return region;
+}
+
+void
+HistoryFile::sync()
+{
+    if (m_map != MAP_FAILED) {
+        msync(m_map, getFileSize(), MS_ASYNC);
+    }
+}
+
+void
+HistoryFile::close()
+{
+    if (m_map != MAP_FAILED) {
+        msync(m_map, getFileSize(), MS_SYNC);
+        munmap(m_map, getFileSize());
+        m_map = MAP_FAILED;
+    }
+    m_header = nullptr;
+    if (m_fd >= 0) {
+        ::close(m_fd);     // releases the lock
+        m_fd = -1;
+    }
+}
@@ -0,0 +1,121 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <glibmm.h>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <cstdint>
+
+#include "TierHistory.hpp"
+
+// the part of the file for one series of values (e.g. Cpu/0)
+//   with the raw values as ring and the tiers.
+//   Only a handle, the data lives in the mapping.
+class HistoryRegion
+{
+public:
+    struct Header
+    {
+        char name[48];
+        std::atomic<uint32_t> head;     // slot of the newest raw value
+        uint32_t reserved;
+        TierHistory::State tiers;
+    };
+
+    HistoryRegion() = default;
+    HistoryRegion(Header* header, uint32_t points);
+
+    bool isValid() const
+    {
+        return m_header != nullptr;
+    }
+    // add the newest raw value
+    void push(double value);
+    // i = 0 oldest ... points - 1 newest
+    double get(uint32_t i) const;
+    TierHistory::State* getTierState()
+    {
+        return &m_header->tiers;
+    }
+    float* getTierValues()
+    {
+        return m_tiers;
+    }
+private:
+    Header* m_header{nullptr};
+    double* m_raw{nullptr};
+    float* m_tiers{nullptr};
+    uint32_t m_points{0u};
+};
+
+// keeps the history of the monitors in a memory mapped file,
+//   so it is shown instantly on restart.
+//   The layout is fixed: header, then regions of the same size
+//   that are allocated by name as the monitors need them.
+//   The values are written to the mapping, sync does a async msync.
+class HistoryFile
+{
+public:
+    HistoryFile(uint32_t points);
+    explicit HistoryFile(const HistoryFile& orig) = delete;
+    virtual ~HistoryFile();
+
+    // map the file, it is recreated if it does not fit (e.g. other points or version)
+    //   false if this is not possible or the file is used by a other instance
+    bool open(const std::string& path);
+    // invalid if not open or no region left
+    HistoryRegion getRegion(const std::string& name, bool create);
+    void sync();
+    uint32_t getPoints() const
+    {
+        return m_points;
+    }
+    // in $XDG_STATE_HOME (default ~/.local/state)
+    static std::string getDefaultPath();
+
+    static constexpr uint32_t VERSION{1u};
+    static constexpr uint32_t REGIONS{128u};
+private:
+    struct Header
+    {
+        char magic[8];
+        uint32_t version;
+        uint32_t points;
+        uint32_t regions;
+        uint32_t regionSize;
+        std::atomic<uint32_t> used;     // regions allocated
+        uint32_t reserved;
+    };
+    static_assert(std::atomic<uint32_t>::is_always_lock_free, "The head has to work in the mapping");
+
+    size_t getRegionSize() const;
+    size_t getFileSize() const;
+    bool isValid() const;
+    void create();
+    void close();
+
+    uint32_t m_points;
+    int m_fd;
+    void* m_map;
+    Header* m_header;
+    std::mutex m_mutex;     // for allocating regions
+    static constexpr char MAGIC[8]{'M', 'O', 'N', 'G', 'L', 'H', 'S', 'T'};
+};
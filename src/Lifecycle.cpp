@@ -0,0 +1,154 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <unistd.h>
+#include <time.h>
+#include <cstring>
+#include <chrono>
+#include <algorithm>
+#include <iterator>
+
+#include "Lifecycle.hpp"
+
+void
+LifecycleEvent::setName(std::string_view value)
+{
+    const size_t len = std::min(value.size(), static_cast<size_t>(NAME_SIZE - 1u));
+    std::memcpy(name, value.data(), len);
+    std::memset(name + len, 0, NAME_SIZE - len);
+}
+
+std::string_view
+LifecycleEvent::getName() const
+{
+    return std::string_view(name, strnlen(name, NAME_SIZE));
+}
+
+LifecycleLog::LifecycleLog(uint32_t capacity)
+: m_mask{0u}
+, m_head{0u}
+, m_spawns{0u}
+, m_exits{0u}
+{
+    uint64_t size = 1u;
+    while (size < capacity) {
+        size <<= 1u;
+    }
+    m_slots = std::make_unique<Slot[]>(size);
+    m_mask = size - 1u;
+}
+
+void
+LifecycleLog::add(const LifecycleEvent& event)
+{
+    const uint64_t pos = m_head.load(std::memory_order_relaxed);
+    Slot& slot = m_slots[pos & m_mask];
+    slot.seq.store(0u, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    slot.type.store(static_cast<uint8_t>(event.type), std::memory_order_relaxed);
+    slot.pid.store(event.pid, std::memory_order_relaxed);
+    slot.ppid.store(event.ppid, std::memory_order_relaxed);
+    for (size_t i = 0; i < std::size(slot.name); ++i) {
+        uint64_t part;
+        std::memcpy(&part, event.name + i * sizeof(part), sizeof(part));
+        slot.name[i].store(part, std::memory_order_relaxed);
+    }
+    slot.timeMs.store(event.timeMs, std::memory_order_relaxed);
+    slot.lifetimeMs.store(event.lifetimeMs, std::memory_order_relaxed);
+    slot.seq.store(pos + 1u, std::memory_order_release);
+    m_head.store(pos + 1u, std::memory_order_release);
+    if (event.type == LifecycleEvent::Type::Spawn) {
+        m_spawns.fetch_add(1u, std::memory_order_relaxed);
+    }
+    else {
+        m_exits.fetch_add(1u, std::memory_order_relaxed);
+    }
+}
+
+uint64_t
+LifecycleLog::read(uint64_t since, std::vector<LifecycleEvent>& events) const
+{
+    const uint64_t head = m_head.load(std::memory_order_acquire);
+    uint64_t pos = since;
+    if (head - std::min(pos, head) > m_mask + 1u) {
+        pos = head - (m_mask + 1u);     // these are overwritten
+    }
+    for (; pos < head; ++pos) {
+        const Slot& slot = m_slots[pos & m_mask];
+        const uint64_t seq = slot.seq.load(std::memory_order_acquire);
+        if (seq != pos + 1u) {
+            continue;
+        }
+        LifecycleEvent event;
+        event.type = static_cast<LifecycleEvent::Type>(slot.type.load(std::memory_order_relaxed));
+        event.pid = slot.pid.load(std::memory_order_relaxed);
+        event.ppid = slot.ppid.load(std::memory_order_relaxed);
+        for (size_t i = 0; i < std::size(slot.name); ++i) {
+            uint64_t part = slot.name[i].load(std::memory_order_relaxed);
+            std::memcpy(event.name + i * sizeof(part), &part, sizeof(part));
+        }
+        event.timeMs = slot.timeMs.load(std::memory_order_relaxed);
+        event.lifetimeMs = slot.lifetimeMs.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.seq.load(std::memory_order_relaxed) == seq) {
+            events.push_back(event);
+        }
+    }
+    return head;
+}
+
+uint64_t
+LifecycleLog::readForks(ProcReader& reader, const char* statFile)
+{
+    if (!reader.read(statFile)) {
+        return 0u;
+    }
+    const char* end = reader.end();
+    for (const char* pos = reader.begin(); pos < end; ) {
+        const char* eol = ProcReader::lineEnd(pos, end);
+        if (eol - pos > 10
+         && std::memcmp(pos, "processes ", 10) == 0) {
+            uint64_t forks;
+            ProcReader::scanUnsigned(pos + 10, eol, forks);
+            return forks;
+        }
+        pos = eol + 1;
+    }
+    return 0u;
+}
+
+int64_t
+LifecycleLog::nowMs()
+{
+    return std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+int64_t
+LifecycleLog::lifetimeMs(unsigned long long startTicks)
+{
+    static const long ticks = sysconf(_SC_CLK_TCK);
+    struct timespec boot;
+    if (ticks <= 0
+     || clock_gettime(CLOCK_BOOTTIME, &boot) != 0) {
+        return 0;
+    }
+    int64_t sinceBootMs = static_cast<int64_t>(boot.tv_sec) * 1000 + boot.tv_nsec / 1000000;
+    int64_t startMs = static_cast<int64_t>(startTicks * 1000ull / static_cast<unsigned long long>(ticks));
+    return std::max(sinceBootMs - startMs, static_cast<int64_t>(0));
+}
@@ -0,0 +1,102 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <cstdint>
+
+#include "ProcReader.hpp"
+
+// a process was seen for the first time or is gone
+struct LifecycleEvent
+{
+    enum class Type : uint8_t {
+        Spawn,
+        Exit
+    };
+    static constexpr auto NAME_SIZE{16u};   // the kernel comm limit (TASK_COMM_LEN)
+    Type type;
+    pid_t pid;
+    pid_t ppid;
+    char name[NAME_SIZE];       // copied, as the log outlives the process, truncated and terminated
+    int64_t timeMs;             // steady clock see nowMs
+    int64_t lifetimeMs;         // since the start of the process (exit only)
+
+    void setName(std::string_view value);
+    std::string_view getName() const;
+};
+
+// a bounded log of process spawns and exits, the oldest events are overwritten.
+//   Written by one thread (the process update), read by any thread without a lock:
+//   each slot keeps a sequence that is checked before and after the copy,
+//   a slot that was overwritten meanwhile is skipped by the reader.
+class LifecycleLog
+{
+public:
+    // the capacity is rounded up to a power of 2
+    LifecycleLog(uint32_t capacity = DEFAULT_CAPACITY);
+    explicit LifecycleLog(const LifecycleLog& orig) = delete;
+    virtual ~LifecycleLog() = default;
+
+    void add(const LifecycleEvent& event);
+    // append the events logged after since (start with 0),
+    //   returns since for the next read
+    uint64_t read(uint64_t since, std::vector<LifecycleEvent>& events) const;
+    // totals, these include the overwritten events
+    uint64_t getSpawns() const
+    {
+        return m_spawns.load(std::memory_order_relaxed);
+    }
+    uint64_t getExits() const
+    {
+        return m_exits.load(std::memory_order_relaxed);
+    }
+    uint32_t getCapacity() const
+    {
+        return static_cast<uint32_t>(m_mask + 1u);
+    }
+    static constexpr auto DEFAULT_CAPACITY{1024u};
+
+    // the forks since boot from the processes line (this counts threads as well), 0 if not readable
+    static uint64_t readForks(ProcReader& reader, const char* statFile = "/proc/stat");
+    static int64_t nowMs();
+    // from the start time in clock ticks after boot (see stat) till now
+    static int64_t lifetimeMs(unsigned long long startTicks);
+private:
+    struct Slot
+    {
+        std::atomic<uint64_t> seq{0u};  // position + 1 if complete, 0 while written
+        std::atomic<uint8_t> type{0u};
+        std::atomic<pid_t> pid{0};
+        std::atomic<pid_t> ppid{0};
+        std::atomic<uint64_t> name[LifecycleEvent::NAME_SIZE / sizeof(uint64_t)]{};
+        std::atomic<int64_t> timeMs{0};
+        std::atomic<int64_t> lifetimeMs{0};
+    };
+    std::unique_ptr<Slot[]> m_slots;
+    uint64_t m_mask;
+    std::atomic<uint64_t> m_head;
+    std::atomic<uint64_t> m_spawns;
+    std::atomic<uint64_t> m_exits;
+};
@@ -0,0 +1,142 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <cstring>
+
+#include "MemDetail.hpp"
+#include "ProcReader.hpp"
+
+MemDetailCollector::MemDetailCollector(const std::string& procDir)
+: m_procDir{procDir}
+, m_pending{false}
+, m_ready{false}
+, m_stop{false}
+, m_thread{&MemDetailCollector::worker, this}
+{
+}
+
+MemDetailCollector::~MemDetailCollector()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_start.notify_one();
+    m_thread.join();
+}
+
+bool
+MemDetailCollector::request(const std::vector<pid_t>& pids)
+{
+    std::unique_lock<std::mutex> lock(m_mutex, std::try_to_lock);
+    if (!lock.owns_lock()
+     || m_pending) {
+        return false;
+    }
+    m_pids = pids;
+    m_pending = true;
+    lock.unlock();
+    m_start.notify_one();
+    return true;
+}
+
+bool
+MemDetailCollector::take(std::vector<MemDetail>& details)
+{
+    std::unique_lock<std::mutex> lock(m_mutex, std::try_to_lock);
+    if (!lock.owns_lock()
+     || !m_ready) {
+        return false;
+    }
+    details.swap(m_results);
+    m_ready = false;
+    return true;
+}
+
+static inline bool
+isKey(const char* pos, const char* lineEnd, const char* key, size_t keyLen)
+{
+    return static_cast<size_t>(lineEnd - pos) >= keyLen
+        && std::memcmp(pos, key, keyLen) == 0;
+}
+
+bool
+MemDetailCollector::parse(const char* begin, const char* end, MemDetail& detail)
+{
+    detail.pssK = 0;
+    detail.ussK = 0;
+    detail.swapK = 0;
+    bool found{false};
+    for (const char* pos = begin; pos < end; ) {
+        const char* eol = ProcReader::lineEnd(pos, end);
+        uint64_t val;
+        if (isKey(pos, eol, "Pss:", 4)) {
+            ProcReader::scanUnsigned(pos + 4, eol, val);
+            detail.pssK = static_cast<long>(val);
+            found = true;
+        }
+        else if (isKey(pos, eol, "Private_Clean:", 14)) {
+            ProcReader::scanUnsigned(pos + 14, eol, val);
+            detail.ussK += static_cast<long>(val);
+        }
+        else if (isKey(pos, eol, "Private_Dirty:", 14)) {
+            ProcReader::scanUnsigned(pos + 14, eol, val);
+            detail.ussK += static_cast<long>(val);
+        }
+        else if (isKey(pos, eol, "Swap:", 5)) {
+            ProcReader::scanUnsigned(pos + 5, eol, val);
+            detail.swapK = static_cast<long>(val);
+        }
+        pos = eol + 1;
+    }
+    return found;
+}
+
+void
+MemDetailCollector::worker()
+{
+    ProcReader reader;
+    std::vector<pid_t> pids;
+    std::vector<MemDetail> results;
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_start.wait(lock, [this] {
+                return m_stop || m_pending;
+            });
+            if (m_stop) {
+                break;
+            }
+            pids.swap(m_pids);
+        }
+        results.clear();
+        for (auto pid : pids) {
+            MemDetail detail;
+            detail.pid = pid;
+            auto name = m_procDir + "/" + std::to_string(pid) + "/smaps_rollup";
+            if (reader.read(name)
+             && parse(reader.begin(), reader.end(), detail)) {
+                results.push_back(detail);
+            }
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_results.swap(results);    // the not taken are replaced
+        m_ready = true;
+        m_pending = false;
+    }
+}
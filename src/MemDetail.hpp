@@ -0,0 +1,66 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <string>
+#include <vector>
+
+// the proportional (pss), unique (uss) and swapped memory of a process
+struct MemDetail
+{
+    pid_t pid;
+    long pssK;
+    long ussK;      // private clean + dirty
+    long swapK;
+};
+
+// reads /proc/[pid]/smaps_rollup on its own thread, as the kernel walks
+//   all mappings of the process for this it is too slow for the update.
+//   The pids are handed out with request and the results picked up with take,
+//   both only try the lock, so the calling (gui) thread never waits for the reading.
+//   Only processes of the user are readable (without CAP_SYS_PTRACE), others are skipped.
+class MemDetailCollector
+{
+public:
+    MemDetailCollector(const std::string& procDir = "/proc");
+    explicit MemDetailCollector(const MemDetailCollector& orig) = delete;
+    virtual ~MemDetailCollector();
+
+    // false if the previous request is still read
+    bool request(const std::vector<pid_t>& pids);
+    // false if there are no new results
+    bool take(std::vector<MemDetail>& details);
+    static bool parse(const char* begin, const char* end, MemDetail& detail);
+private:
+    void worker();
+
+    std::string m_procDir;
+    std::mutex m_mutex;
+    std::condition_variable m_start;
+    std::vector<pid_t> m_pids;
+    std::vector<MemDetail> m_results;
+    bool m_pending;     // requested but not finished
+    bool m_ready;       // results not taken
+    bool m_stop;
+    std::thread m_thread;   // last, as it uses the members above
+};
@@ -134,46 +134,15 @@ MemMonitor::printInfo()
 }
 
 void
-MemMonitor::updateG15(Cairo::RefPtr<Cairo::Context> cr, guint width, guint height)
+MemMonitor::fillG15(G15Frame& frame)
 {
-//    sprintf(temp, "Fr: 0x%x", result);
-//    cr->move_to(100.0, 10.0);
-//    cr->show_text(temp);
-
-    auto temp = Glib::ustring::sprintf("Mem:%.1fG", (double)mem_total / 1024.0 / 1024.0);
-    cr->move_to(1.0, 10.0);
-    cr->show_text(temp);
-//
-//    sprintf(temp, "Fre: %.1fG", (float)mem_free / 1024.0 / 1024.0);
-//    cr->move_to(1.0, 20.0);
-//    cr->show_text(temp);
-//
-//    sprintf(temp, "Buf: %.1fG", (float)(mem_buffers + mem_cached) / 1024.0 / 1024.0);
-//    cr->move_to(1.0, 30.0);
-//    cr->show_text(temp);
-
-    temp = Glib::ustring::sprintf(temp, "Use:%.1fG", (double)getUsedMemory() / 1024.0 / 1024.0);
-    cr->move_to(0.0, 20.0);
-    cr->show_text(temp);
-
-    temp = Glib::ustring::sprintf("Swap:%.1fG", (double)(swap_total - swap_free) / 1024.0 / 1024.0);
-    cr->move_to(0.0, 30.0);
-    cr->show_text(temp);
-
-    cr->rectangle(60.5, 0.5, width-61, height-1);
-    cr->stroke();
-    double x = width - 1.5;
-    for (int i = m_size-1; i >= 0; --i)
-    {
-        cr->move_to(x, height-1);
-        float y = (gfloat)(height-1) - getValues(0)->get(i)*(gfloat)(height-2);
-        cr->line_to(x, y);
-        x -= 1.0;
-        if (x <= 60.0) {
-            break;
-        }
+    frame.lines.push_back(Glib::ustring::sprintf("Mem:%.1fG", (double)mem_total / 1024.0 / 1024.0));
+    frame.lines.push_back(Glib::ustring::sprintf("Use:%.1fG", (double)getUsedMemory() / 1024.0 / 1024.0));
+    frame.lines.push_back(Glib::ustring::sprintf("Swap:%.1fG", (double)(swap_total - swap_free) / 1024.0 / 1024.0));
+    frame.framed = true;
+    for (guint i = 0; i < m_size; ++i) {
+        frame.values.push_back(getValues(0)->get(i));
     }
-    cr->stroke();
 }
 
 void
@@ -34,7 +34,7 @@ public:
 
     Gtk::Box* create_config_page(MonglView *monglView) override;
 
-    void updateG15(Cairo::RefPtr<Cairo::Context> cr, guint width, guint height) override;
+    void fillG15(G15Frame& frame) override;
 
     unsigned long getTotal() override;
     std::string getPrimMax() override;
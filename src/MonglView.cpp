@@ -23,6 +23,9 @@
 #include <cstdlib>
 #include <iomanip>
 #include <fstream>
+#include <algorithm>
+#include <cerrno>
+#include <array>
 #include <Log.hpp>
 #include <TreeGeometry2.hpp>
 #include <Font2.hpp>
@@ -36,6 +39,7 @@
 #include "GpuMonitor.hpp"
 #include "NetMonitor.hpp"
 #include "ClkMonitor.hpp"
+#include "ChurnMonitor.hpp"
 #include "GraphShaderContext.hpp"
 #include "InfoPage.hpp"
 #include "Processes.hpp"
@@ -47,7 +51,7 @@ MonglView::MonglView(Gtk::Application* application)
 : Scene()
 , m_graph_shaderContext{nullptr}
 , m_textContext{nullptr}
-, m_updateInterval{MIN_UPDATE_PERIOD}
+, m_updateInterval{1000}
 , m_glibtop{nullptr}
 , m_diagrams()
 , m_config{nullptr}
@@ -58,12 +62,33 @@ MonglView::MonglView(Gtk::Application* application)
 , m_diskInfos{std::make_shared<DiskInfos>()}
 , m_application{application}
 , m_log{psc::log::Log::create("monglmm")}
+, m_sampledDispatcher()
+, m_sampleNetConnections{true}
+, m_filesysTicks{1u}
+, m_netConnectionTicks{1u}
+, m_filesysDue{true}
+, m_netConnectionDue{true}
+, m_collectorChanges()
+, m_historyTier{TierHistory::RAW}
+, m_historyFile()
+, m_historySyncTicks{1u}
+, m_historySyncDue{false}
+, m_sampleSkips{0u}
 {
 
     read_config();
     if (m_config != nullptr) {
-        config_setting_lookup_int(m_config, CONFIG_GRP_MAIN, CONFIG_UPDATE_INTERVAL,
-                                  &m_updateInterval);
+        if (has_setting(m_config, CONFIG_GRP_MAIN, CONFIG_UPDATE_INTERVAL_MS)) {
+            config_setting_lookup_int(m_config, CONFIG_GRP_MAIN, CONFIG_UPDATE_INTERVAL_MS,
+                                      &m_updateInterval);
+        }
+        else {
+            int updateSeconds = 1;
+            config_setting_lookup_int(m_config, CONFIG_GRP_MAIN, CONFIG_UPDATE_INTERVAL,
+                                      &updateSeconds);
+            m_updateInterval = updateSeconds * 1000;
+        }
+        m_updateInterval = std::clamp(m_updateInterval, MIN_UPDATE_PERIOD, MAX_UPDATE_PERIOD);
         if (!config_setting_lookup_color(m_config, CONFIG_GRP_MAIN, CONFIG_TEXT_COLOR,
                                   m_text_color)) {
             m_text_color = Gdk::RGBA(TEXT_DEFAULT_COLOR);
@@ -77,6 +102,37 @@ MonglView::MonglView(Gtk::Application* application)
                                   uProcessType)) {
             m_processes.setTreeType(uProcessType);
         }
+        int scanThreads = static_cast<int>(ProcessesBase::DEFAULT_SCAN_THREADS);
+        config_setting_lookup_int(m_config, CONFIG_GRP_MAIN, CONFIG_SCAN_THREADS,
+                                  &scanThreads);
+        m_processes.setScanThreads(static_cast<uint32_t>(std::max(scanThreads, 1)));
+        int processOpenFiles = 0;
+        config_setting_lookup_int(m_config, CONFIG_GRP_MAIN, CONFIG_PROCESS_OPEN_FILES,
+                                  &processOpenFiles);
+        m_processes.setMaxOpenFiles(static_cast<uint32_t>(std::max(processOpenFiles, 0)));
+        int processEvents = 0;
+        config_setting_lookup_int(m_config, CONFIG_GRP_MAIN, CONFIG_PROCESS_EVENTS,
+                                  &processEvents);
+        if (processEvents > 0) {
+            m_processes.setProcEvents(std::make_unique<NetlinkProcEvents>(), static_cast<uint32_t>(processEvents));
+        }
+        int topProcesses = static_cast<int>(Processes::TOP_PROC);
+        config_setting_lookup_int(m_config, CONFIG_GRP_MAIN, CONFIG_TOP_PROCESSES,
+                                  &topProcesses);
+        m_processes.setTopCount(static_cast<uint32_t>(std::max(topProcesses, 1)));
+        m_processes.setCollectIo(config_setting_lookup_boolean(m_config, CONFIG_GRP_MAIN, CONFIG_PROCESS_IO, false));
+        int idleCadence = static_cast<int>(ProcessesBase::DEFAULT_IDLE_CADENCE);
+        config_setting_lookup_int(m_config, CONFIG_GRP_MAIN, CONFIG_PROCESS_IDLE_CADENCE,
+                                  &idleCadence);
+        m_processes.setIdleCadence(static_cast<uint32_t>(std::max(idleCadence, 0)));
+        int memDetail = static_cast<int>(Processes::DEFAULT_MEM_DETAIL_INTERVAL);
+        config_setting_lookup_int(m_config, CONFIG_GRP_MAIN, CONFIG_PROCESS_MEM_DETAIL,
+                                  &memDetail);
+        m_processes.setMemDetailInterval(static_cast<uint32_t>(std::max(memDetail, 0)));
+        int historyTier = static_cast<int>(TierHistory::RAW);
+        config_setting_lookup_int(m_config, CONFIG_GRP_MAIN, CONFIG_HISTORY_TIER,
+                                  &historyTier);
+        m_historyTier = static_cast<TierHistory::Tier>(std::clamp(historyTier, 0, TierHistory::TIERS - 1));
         Glib::ustring uLogLevel;
         if (config_setting_lookup_string(m_config, CONFIG_GRP_MAIN, CONFIG_LOGLEVEL,
                                   uLogLevel)) {
@@ -90,6 +146,7 @@ MonglView::MonglView(Gtk::Application* application)
 #endif
 
     m_Dispatcher.connect(sigc::mem_fun(*this, &MonglView::on_notification_from_worker_thread));
+    m_sampledDispatcher.connect(sigc::mem_fun(*this, &MonglView::on_sampled));
 
     create_popup();
 }
@@ -170,31 +227,147 @@ MonglView::init_shaders(Glib::Error &error)
     return TRUE;
 }
 
+bool
+MonglView::on_tick(Glib::IOCondition condition)
+{
+    if (m_scheduler.expired() > 0u) {
+        monitors_update();
+    }
+    return true;
+}
+
+// the reading is done by the sampler, so the gui is not blocked by slow files
 gboolean
 MonglView::monitors_update()
 {
+    if (m_sampler->isBusy()) {
+        // the due flags belong to the running sample, the ticks skipped are due with the next
+        if (m_sampleSkips++ == 0u) {
+            psc::log::Log::logAdd(psc::log::Level::Info, "Sampling takes longer than the update interval, skipping");
+        }
+        return true;
+    }
+    if (m_sampleSkips > 0u) {
+        psc::log::Log::logAdd(psc::log::Level::Info, Glib::ustring::sprintf("Sampling resumed after %u skipped updates", m_sampleSkips));
+        m_sampleSkips = 0u;
+    }
+    if (m_sampler->take()) {
+        present();      // the notification is still queued
+    }
+    applyCollectorChanges();
+    for (auto& d : m_diagrams) {
+        d->setDue(m_scheduler.isDue(d->getUpdateTicks()));
+    }
+    m_filesysDue = m_scheduler.isDue(m_filesysTicks);
+    m_netConnectionDue = m_scheduler.isDue(m_netConnectionTicks);
+    m_historySyncDue = m_scheduler.isDue(m_historySyncTicks);
+    m_sampleNetConnections = config_setting_lookup_boolean(m_config, CONFIG_GRP_MAIN, CONFIG_SHOW_NET_CONNECT, true);
+    if (m_sampler->request()) {
+        m_scheduler.mark();
+    }
+    return true;
+}
+
+// called by the sampler thread, keep to the collectors
+void
+MonglView::sample()
+{
+    if (m_diskInfos) {
+        bool diskStatDue = m_filesysDue;
+        for (auto& d : m_diagrams) {
+            diskStatDue |= d->isDue() && d->getMonitor()->isDiskStatBound();
+        }
+        if (diskStatDue) {      // before the monitors, so these get the actual rates
+            m_diskInfos->updateDiskStat(m_updateInterval, m_glibtop);
+        }
+        if (m_filesysDue) {
+            m_diskInfos->updateMounts(m_updateInterval, m_glibtop);
+        }
+    }
+    for (auto& d : m_diagrams) {
+        if (d->isDue()) {
+            d->sample(m_updateInterval, m_glibtop);
+        }
+    }
+    // the load is relative to the cpu, so follow its rate
+    if (m_diagrams[0]->isDue()) {
+        m_processes.sample();   // a process stuck in /proc shall not block the gui
+    }
+    if (m_netInfo
+     && m_sampleNetConnections
+     && m_netConnectionDue) {
+        m_netInfo->update();
+    }
+}
+
+void
+MonglView::on_sampled()
+{
+    if (m_sampler
+     && m_sampler->take()) {
+        present();
+        applyCollectorChanges();
+    }
+}
+
+void
+MonglView::changeCollectors(const std::function<void()>& change)
+{
+    if (m_sampler
+     && m_sampler->isBusy()) {
+        m_collectorChanges.push_back(change);
+    }
+    else {
+        change();   // as only the gui requests, it stays idle
+    }
+}
+
+void
+MonglView::applyCollectorChanges()
+{
+    for (auto& change : m_collectorChanges) {
+        change();
+    }
+    m_collectorChanges.clear();
+}
+
+void
+MonglView::present()
+{
+    if (!m_graph_shaderContext) {
+        return;     // unrealized
+    }
     /* we need to ensure that the GdkGLContext is set before calling GL API */
     naviGlArea->make_current();
 
-    for (auto d : m_diagrams) {
-        d->update(m_updateInterval, m_glibtop);
+    for (auto& d : m_diagrams) {
+        d->present(m_updateInterval, m_glibtop);   // the others move along the time axis
+    }
+    // the processes own the geometry of the tree, so the sample is applied here
+    if (m_diagrams[0]->isDue()) {
+        m_processes.update(m_diagrams[0]->getMonitor(), m_diagrams[1]->getMonitor());
     }
-    m_processes.update(m_diagrams[0]->getMonitor(), m_diagrams[1]->getMonitor());
+    m_processes.updateGeometry(m_graph_shaderContext, m_textContext, m_font2, m_diagrams[0], m_diagrams[1], m_diagrams[3], m_projView);  // cpu, mem, disk
 
-    if (m_diskInfos) {
-        m_diskInfos->update(m_updateInterval, m_glibtop);
+    if (m_diskInfos
+     && m_filesysDue) {
+        m_diskInfos->updateGeometries();
     }
     // update after disk as it depends on it
-    if (m_filesyses) {
+    if (m_filesyses
+     && m_filesysDue) {
         m_filesyses->update(m_graph_shaderContext, m_textContext, m_font2, m_projView, m_updateInterval);
+#ifdef LIBG15
+        m_filesyses->publishG15();
+#endif
     }
-    bool showNetConnections = config_setting_lookup_boolean(m_config, CONFIG_GRP_MAIN, CONFIG_SHOW_NET_CONNECT, true);
-    if (m_netInfo && showNetConnections) {
-        m_netInfo->update();
+    if (m_historyFile
+     && m_historySyncDue) {
+        m_historyFile->sync();  // the values are in the mapping, just let the kernel know
     }
     naviGlArea->queue_render();
 #ifdef LIBG15
-    worker->refresh();   // sync these updates
+    worker->refresh();   // sync these updates (the pages are published by now)
 #endif
 
 	// try to solve ram mistery
@@ -208,8 +381,6 @@ MonglView::monitors_update()
     // Might be useful http://man7.org/linux/man-pages/man3/malloc_info.3.html
     // https://udrepper.livejournal.com/20948.html
     //malloc_info(0, stdout);
-
-    return true;
 }
 
 
@@ -225,15 +396,45 @@ MonglView::on_notification_from_worker_thread()
 #endif
 }
 
+uint32_t
+MonglView::getTicks(const char* grp, const char* key, guint preferredPeriod)
+{
+    if (m_config != nullptr
+     && has_setting(m_config, grp, key)) {
+        int ticks = 1;
+        config_setting_lookup_int(m_config, grp, key, &ticks);
+        return static_cast<uint32_t>(std::max(ticks, 1));
+    }
+    const auto interval = static_cast<guint>(m_updateInterval);
+    return std::max((preferredPeriod + interval - 1u) / interval, 1u);
+}
+
+void
+MonglView::update_ticks()
+{
+    for (auto& d : m_diagrams) {
+        auto m = d->getMonitor();
+        d->setUpdateTicks(getTicks(m->m_name, CONFIG_UPDATE_TICKS, m->getPreferredPeriod()));
+    }
+    m_filesysTicks = getTicks(CONFIG_GRP_MAIN, CONFIG_FILESYS_TICKS, FILESYS_PERIOD);
+    m_netConnectionTicks = getTicks(CONFIG_GRP_MAIN, CONFIG_NET_CONNECT_TICKS, 0u);
+    m_historySyncTicks = std::max(HISTORY_SYNC_PERIOD / static_cast<guint>(m_updateInterval), 1u);
+}
+
 void
 MonglView::update_timer()
 {
     if (m_timer.connected())
         m_timer.disconnect(); // No more updating
+    update_ticks();
 
-    m_timer = Glib::signal_timeout().connect_seconds(
-                    sigc::mem_fun(*this, &MonglView::monitors_update), m_updateInterval);
-    m_log->info(Glib::ustring::sprintf("Using update interval %d", m_updateInterval));
+    if (!m_scheduler.start(static_cast<uint32_t>(m_updateInterval))) {
+        m_log->error(Glib::ustring::sprintf("Error creating timer %d", errno));
+        return;
+    }
+    m_timer = Glib::signal_io().connect(
+                    sigc::mem_fun(*this, &MonglView::on_tick), m_scheduler.getFd(), Glib::IO_IN);
+    m_log->info(Glib::ustring::sprintf("Using update interval %dms", m_updateInterval));
 }
 
 void
@@ -263,22 +464,35 @@ MonglView::init(Gtk::GLArea *glArea)
     graphs.push_back(gpu);
     std::shared_ptr<Monitor> clk = std::make_shared<ClkMonitor>(n_values);
     graphs.push_back(clk);
+    std::shared_ptr<Monitor> churn = std::make_shared<ChurnMonitor>(n_values, m_processes.getLifecycle());
+    graphs.push_back(churn);
     m_filesyses->setDiskInfos(m_diskInfos);
 #if defined(LMSENSORS) || defined(RASPI)
     m_temp = std::make_shared<TempMonitor>(n_values);
     graphs.push_back(m_temp);
 #endif
 
+    if (!m_historyFile
+     && config_setting_lookup_boolean(m_config, CONFIG_GRP_MAIN, CONFIG_HISTORY_FILE, false)) {
+        auto historyFile = std::make_unique<HistoryFile>(n_values);
+        auto path = HistoryFile::getDefaultPath();
+        if (historyFile->open(path)) {
+            m_log->info(Glib::ustring::sprintf("Using history %s", path));
+            m_historyFile = std::move(historyFile);
+        }
+    }
     /* initialize the diagram  */
     Position pos(-1.0f, 3.8f, 0.0f);
     for (auto m : graphs) {
         if (m_config != nullptr) {
             m->load_settings(m_config);
         }
+        m->setHistoryFile(m_historyFile.get());     // before the diagram shows the values
         std::shared_ptr<DiagramMonitor> d = std::make_shared<DiagramMonitor>(m, m_graph_shaderContext, m_textContext);
         m_graph_shaderContext->addGeometry(d->getBase());
         m_diagrams.push_back(d);
         d->setFont(m_font2);
+        d->setTier(m_historyTier);
         d->setPosition(pos);
         Glib::ustring sname = m->getDisplayName();
         d->setName(sname);
@@ -306,6 +520,13 @@ MonglView::init(Gtk::GLArea *glArea)
     });
 #endif
 
+    m_sampler = std::make_unique<Sampler>(
+                    [this] {
+                        sample();
+                    },
+                    [this] {
+                        m_sampledDispatcher.emit();
+                    });
     monitors_update();      // update immediate to get faster display, drawback longer startup
 
     update_timer();
@@ -323,6 +544,10 @@ MonglView::unrealize()
     if (m_timer.connected()) {
         m_timer.disconnect(); // No more updating
     }
+    m_scheduler.stop();
+    if (m_sampler) {
+        m_sampler->stop();  // before the collectors are removed
+    }
     /* we need to ensure that the GdkGLContext is set before calling GL API */
 #ifdef LIBG15
     if (m_config) {
@@ -400,7 +625,7 @@ MonglView::getConfig()
 
 gint MonglView::getUpdateInterval()
 {
-    return m_updateInterval;
+    return std::max(m_updateInterval / 1000, 1);
 }
 
 void
@@ -426,12 +651,12 @@ MonglView::drawContent()
         m_projView = naviGlArea->getProjection() * naviGlArea->getView();
 
         m_graph_shaderContext->setLight();
-        if (m_netInfo) {
+        if (m_netInfo
+         && (!m_sampler || !m_sampler->isBusy())) {     // the connections are changed by the sampler
             bool showNetConnections = config_setting_lookup_boolean(m_config, CONFIG_GRP_MAIN, CONFIG_SHOW_NET_CONNECT, true);
             m_netInfo->draw(m_graph_shaderContext, m_textContext, m_font2, showNetConnections);
         }
-        // update after processe as it depends on it
-        m_processes.display(m_graph_shaderContext, m_textContext, m_font2, m_diagrams[0], m_diagrams[1], m_projView);
+        m_processes.displayTops(m_graph_shaderContext, m_projView);    // the geometry is updated with present
 
 //        if (m_filesyses) {
 //            auto geos = m_filesyses->getGeometries();
@@ -477,9 +702,12 @@ MonglView::draw(Gtk::GLArea *glArea, Matrix &proj, Matrix &view)
 void
 MonglView::update_interval_changed(Gtk::SpinButton* refresh_spin)
 {
-    m_updateInterval = refresh_spin->get_value_as_int();
-    config_group_set_int(m_config, CONFIG_GRP_MAIN, CONFIG_UPDATE_INTERVAL, m_updateInterval);
-    update_timer();
+    int updateInterval = refresh_spin->get_value_as_int();
+    changeCollectors([this, updateInterval] {  // the sampler passes the interval
+        m_updateInterval = updateInterval;
+        config_group_set_int(m_config, CONFIG_GRP_MAIN, CONFIG_UPDATE_INTERVAL_MS, m_updateInterval);
+        update_timer();
+    });
 }
 
 void
@@ -511,7 +739,9 @@ MonglView::process_type_changed(Gtk::ComboBoxText* process_type)
     Glib::ustring procType(process_type->get_active_id());
 
     config_group_set_string(m_config, CONFIG_GRP_MAIN, CONFIG_PROCESSTYPE, procType);
-    m_processes.setTreeType(procType);
+    changeCollectors([this, procType] {     // the processes (and cgroups) are used by the sampler
+        m_processes.setTreeType(procType);
+    });
 
     naviGlArea->queue_render();
 }
@@ -530,6 +760,7 @@ Gtk::Dialog *
 MonglView::monitors_config()
 {
     Gtk::Dialog *dlg = new Gtk::Dialog("Resource monitors", Gtk::DialogFlags::DIALOG_MODAL | Gtk::DialogFlags::DIALOG_DESTROY_WITH_PARENT);
+    // the changes of the collectors are handed over with changeCollectors
 
     //dlg->add_button(Gtk::BuiltinStockID::CLOSE);
     Gtk::Box *c_area = dlg->get_content_area();
@@ -540,10 +771,10 @@ MonglView::monitors_config()
     notebook->append_page(*general_box, "General", FALSE);
 
     auto refresh_spin = Gtk::manage(new Gtk::SpinButton());
-    refresh_spin->set_increments(1, 10);
+    refresh_spin->set_increments(50, 500);
     refresh_spin->set_range(MIN_UPDATE_PERIOD, MAX_UPDATE_PERIOD);
     refresh_spin->set_value(m_updateInterval);
-    Monitor::add_widget2box(general_box, "Update interval (s)", refresh_spin, 0.0f);
+    Monitor::add_widget2box(general_box, "Update interval (ms)", refresh_spin, 0.0f);
     refresh_spin->signal_changed().connect(sigc::bind<Gtk::SpinButton *>(
                                            sigc::mem_fun(*this, &MonglView::update_interval_changed),
                                            refresh_spin));
@@ -567,6 +798,7 @@ MonglView::monitors_config()
     process_type->append("a", "Arc");
     process_type->append("b", "Block");
     process_type->append("l", "Line");
+    process_type->append("c", "Cgroup");
     Monitor::add_widget2box(general_box, "Process display", process_type, 0.0f);
     Glib::ustring uProcessType;
     if (config_setting_lookup_string(m_config, CONFIG_GRP_MAIN, CONFIG_PROCESSTYPE,
@@ -628,9 +860,48 @@ MonglView::create_popup()
             sigc::mem_fun(*this, &MonglView::restore) );
     m_popupMenu.append(*itemRestore);
 
+    auto itemAxis = Gtk::make_managed<Gtk::MenuItem>("Time _axis", true);
+    auto axisMenu = Gtk::make_managed<Gtk::Menu>();
+    itemAxis->set_submenu(*axisMenu);
+    Gtk::RadioMenuItem::Group group;
+    const std::array<const char*, TierHistory::TIERS> labels{"_Updates", "10 _seconds", "1 _minute", "10 m_inutes"};
+    for (int t = 0; t < TierHistory::TIERS; ++t) {
+        auto itemTier = Gtk::make_managed<Gtk::RadioMenuItem>(group, labels[t], true);
+        itemTier->set_active(t == m_historyTier);
+        itemTier->signal_toggled().connect(sigc::bind(
+            sigc::mem_fun(*this, &MonglView::history_tier_changed), itemTier, static_cast<TierHistory::Tier>(t)));
+        axisMenu->append(*itemTier);
+    }
+    m_popupMenu.append(*itemAxis);
+
     m_popupMenu.show_all();
 }
 
+void
+MonglView::history_tier_changed(Gtk::RadioMenuItem* item, TierHistory::Tier tier)
+{
+    if (!item->get_active()) {
+        return;     // the previous one is toggled as well
+    }
+    m_historyTier = tier;
+    bool idle = m_sampler && !m_sampler->isBusy();
+    if (idle) {
+        naviGlArea->make_current();
+    }
+    for (auto& d : m_diagrams) {
+        d->setTier(tier);
+        if (idle) {     // otherwise with the next update
+            d->refill();
+        }
+    }
+    if (idle) {
+        naviGlArea->queue_render();
+    }
+    if (m_config != nullptr) {
+        config_group_set_int(m_config, CONFIG_GRP_MAIN, CONFIG_HISTORY_TIER, static_cast<int>(tier));
+    }
+}
+
 void
 MonglView::on_process_properties()
 {
@@ -643,7 +914,7 @@ MonglView::on_process_properties()
                 if (treeNode) {
                     auto process = std::dynamic_pointer_cast<Process>(treeNode);
                     if (process) {
-                        ProcessProperties* procProp = ProcessProperties::show(process->getPid(), m_config, m_updateInterval);
+                        ProcessProperties* procProp = ProcessProperties::show(process->getPid(), &m_processes, m_config, getUpdateInterval());
                         if (procProp) {
                             procProp->run();
                             save_config();
@@ -673,8 +944,10 @@ MonglView::showMessage(const Glib::ustring& msg, Gtk::MessageType msgType)
 
 void
 MonglView::restore() {
-    m_processes.restore();
-    naviGlArea->queue_render();
+    changeCollectors([this] {
+        m_processes.restore();
+        naviGlArea->queue_render();
+    });
 }
 
 psc::gl::aptrGeom2
@@ -703,6 +976,12 @@ MonglView::selectionChanged(const psc::gl::aptrGeom2& prev_selected, const psc::
 void
 MonglView::close()
 {
+    if (m_sampler) {
+        m_sampler->stop();
+    }
+    if (m_historyFile) {
+        m_historyFile->sync();
+    }
     // close hardware related resources
 #ifdef LIBG15
     if (worker != nullptr) {
@@ -22,6 +22,7 @@
 #include <future>
 #include <vector>
 #include <memory>
+#include <functional>
 #include <Log.hpp>
 #include <Geom2.hpp>
 #include <Matrix.hpp>
@@ -39,6 +40,9 @@
 #include "DiagramMonitor.hpp"
 #include "monglmm_config.h"
 #include "NetInfo.hpp"
+#include "Sampler.hpp"
+#include "Scheduler.hpp"
+#include "HistoryFile.hpp"
 #ifdef LIBG15
 #include "G15Worker.hpp"
 #else
@@ -66,15 +70,19 @@ public:
     bool selectionChanged(const psc::gl::aptrGeom2& prev_selected, const psc::gl::aptrGeom2& selected) override;
     bool on_click(GdkEventButton* event, float mx, float my) override;
     void create_popup();
+    void history_tier_changed(Gtk::RadioMenuItem* item, TierHistory::Tier tier);
     void on_process_properties();
     void restore();
     void close();
     void showMessage(const Glib::ustring& msg, Gtk::MessageType msgType = Gtk::MessageType::MESSAGE_INFO);
     Glib::KeyFile* getConfig();
-    gint getUpdateInterval();
+    gint getUpdateInterval();   // seconds, for the dialogs
     static constexpr auto CONFIG_SHOW_NET_CONNECT = "showNetConnections";
     static constexpr auto CONFIG_GRP_MAIN = "Main";
     void net_connections_show_changed(Gtk::CheckButton* showNetConn);
+    // the collectors belong to the sampler from request to take,
+    //   so a change (e.g. from the config dialog) is kept until then
+    void changeCollectors(const std::function<void()>& change);
 protected:
 
 private:
@@ -83,8 +91,9 @@ private:
     psc::gl::ptrFont2 m_font2;
 
     sigc::connection    m_timer;               /* Timer for regular updates     */
+    Scheduler m_scheduler;
 
-    gint m_updateInterval;
+    gint m_updateInterval;  // ms
 
     glibtop *m_glibtop;                        /* portable way to get infos (needs .configure --with-glibtop) */
     std::vector<std::shared_ptr<DiagramMonitor>> m_diagrams;
@@ -96,7 +105,15 @@ private:
     Glib::Dispatcher m_Dispatcher;  // used for thread notification
 
     gboolean monitors_update();
+    bool on_tick(Glib::IOCondition condition);
+    void sample();
+    void present();
+    void on_sampled();
     void update_timer();
+    void applyCollectorChanges();
+    // adjust the ticks to the update interval
+    void update_ticks();
+    uint32_t getTicks(const char* grp, const char* key, guint preferredPeriod);
     void update_interval_changed(Gtk::SpinButton* refresh_spin);
     void text_color_changed(Gtk::ColorButton* text_color);
     void process_type_changed(Gtk::ComboBoxText* process_type);
@@ -115,13 +132,41 @@ private:
     std::shared_ptr<Monitor> m_temp;
     std::shared_ptr<NetInfo> m_netInfo;
     std::shared_ptr<psc::log::Log> m_log;
+    Glib::Dispatcher m_sampledDispatcher;
+    bool m_sampleNetConnections;    // the config is read only by the gui
+    uint32_t m_filesysTicks;
+    uint32_t m_netConnectionTicks;
+    bool m_filesysDue;
+    bool m_netConnectionDue;
+    std::vector<std::function<void()>> m_collectorChanges;    // to apply while the sampler is idle
+    TierHistory::Tier m_historyTier;  // the time axis of the graphs
+    std::unique_ptr<Sampler> m_sampler;
+    std::unique_ptr<HistoryFile> m_historyFile;     // optional, used by the monitors
+    uint32_t m_historySyncTicks;
+    bool m_historySyncDue;
+    uint32_t m_sampleSkips;     // updates skipped while the sampler is busy, logged once per stall
     static constexpr auto CONFIG_LOGLEVEL = "logLevel";
-    static constexpr auto MIN_UPDATE_PERIOD = 1;              /* Seconds (minimum)    */
-    static constexpr auto MAX_UPDATE_PERIOD = 60;              /* Seconds (maximum)    */
-    static constexpr auto CONFIG_UPDATE_INTERVAL = "UpdateInterval";
+    static constexpr auto MIN_UPDATE_PERIOD = 100;              /* ms (minimum)    */
+    static constexpr auto MAX_UPDATE_PERIOD = 60000;            /* ms (maximum)    */
+    static constexpr auto CONFIG_UPDATE_INTERVAL = "UpdateInterval";    // seconds, used if there is no ms
+    static constexpr auto CONFIG_UPDATE_INTERVAL_MS = "UpdateIntervalMs";
+    static constexpr auto CONFIG_UPDATE_TICKS = "updateTicks";      // in the group of each monitor
+    static constexpr auto CONFIG_FILESYS_TICKS = "filesysTicks";
+    static constexpr auto CONFIG_NET_CONNECT_TICKS = "netConnectionTicks";
+    static constexpr auto CONFIG_HISTORY_TIER = "historyTier";     // 0 updates, 1 10s, 2 1min, 3 10min
+    static constexpr auto CONFIG_HISTORY_FILE = "historyFile";     // keep the history across restarts
+    static constexpr auto HISTORY_SYNC_PERIOD = 60000u;            /* ms */
+    static constexpr auto FILESYS_PERIOD = 2000u;              /* ms, the usage changes slowly */
     static constexpr auto CONFIG_TEXT_COLOR = "TextColor";
     static constexpr auto CONFIG_BACKGOUNDCOLOR = "BackgroundColor";
     static constexpr auto CONFIG_PROCESSTYPE = "processType";
+    static constexpr auto CONFIG_SCAN_THREADS = "scanThreads";
+    static constexpr auto CONFIG_PROCESS_OPEN_FILES = "processOpenFiles";
+    static constexpr auto CONFIG_TOP_PROCESSES = "topProcesses";
+    static constexpr auto CONFIG_PROCESS_EVENTS = "processEvents";
+    static constexpr auto CONFIG_PROCESS_IO = "processIo";
+    static constexpr auto CONFIG_PROCESS_IDLE_CADENCE = "processIdleCadence";
+    static constexpr auto CONFIG_PROCESS_MEM_DETAIL = "processMemDetail";
     static constexpr auto TEXT_DEFAULT_COLOR = "#AAAAAA";
     static constexpr auto BACKGROUND_DEFAULT_COLOR = "#0F0F1F";
     static constexpr auto DIAGRAM_GAP = 0.2f;
@@ -22,6 +22,7 @@
 #include <iostream>
 #include <fstream>
 #include <iomanip>
+#include <algorithm>
 #include <StringUtils.hpp>
 #include <psc_format.hpp>
 
@@ -43,11 +44,94 @@ Monitor::~Monitor()
 
 void
 Monitor::roll() {
+    if (m_sampleTime > 0l) {
+        consolidate(m_sampleTime);
+    }
+    m_sampleTime = g_get_real_time();   // as the update follows
     for (auto p : m_Stats) {
         p->roll();
     }
 }
 
+TierHistory&
+Monitor::getTiers(unsigned int diagram)
+{
+    while (m_tiers.size() <= diagram) {
+        HistoryRegion region;
+        if (m_historyFile) {
+            region = m_historyFile->getRegion(Glib::ustring::sprintf("%s/%u", m_name, static_cast<guint>(m_tiers.size())), true);
+        }
+        if (region.isValid()) {
+            m_tiers.push_back(std::make_unique<TierHistory>(m_size, region.getTierState(), region.getTierValues()));
+        }
+        else {
+            m_tiers.push_back(std::make_unique<TierHistory>(m_size));
+        }
+        m_regions.push_back(region);
+    }
+    return *m_tiers[diagram];
+}
+
+void
+Monitor::record(unsigned int diagram, double value, gint64 sampleUs)
+{
+    getTiers(diagram).add(value, sampleUs);
+    auto& region = m_regions[diagram];
+    if (region.isValid()) {
+        region.push(value);
+    }
+}
+
+void
+Monitor::consolidate(gint64 sampleUs)
+{
+    for (unsigned int i = 0; i < m_Stats.size(); ++i) {
+        record(i, m_Stats[i]->get(m_size - 1u), sampleUs);    // the newest
+    }
+}
+
+void
+Monitor::setHistoryFile(HistoryFile* file)
+{
+    m_historyFile = file != nullptr && file->getPoints() == m_size ? file : nullptr;
+    m_tiers.clear();
+    m_regions.clear();
+    if (m_historyFile) {
+        for (unsigned int i = 0; ; ++i) {
+            auto region = m_historyFile->getRegion(Glib::ustring::sprintf("%s/%u", m_name, i), false);
+            if (!region.isValid()) {
+                break;
+            }
+            restore(i, region);
+        }
+    }
+}
+
+void
+Monitor::restore(unsigned int diagram, const HistoryRegion& region)
+{
+    auto values = getValues(diagram);
+    for (guint i = 0; i < m_size; ++i) {
+        values->set(i, region.get(i));
+    }
+    values->refreshSum();
+}
+
+void
+Monitor::getValues(unsigned int diagram, TierHistory::Tier tier, TierHistory::Stat stat, Buffer<double>& buffer)
+{
+    if (tier == TierHistory::RAW) {
+        auto values = getValues(diagram);
+        for (guint i = 0; i < m_size; ++i) {
+            buffer.set(i, values->get(i));
+        }
+        buffer.refreshSum();
+    }
+    else {
+        getTiers(diagram).fill(tier, stat, buffer);
+    }
+}
+
 std::shared_ptr<Buffer<double>>
 Monitor::getValues(unsigned int diagram) {
     while (m_Stats.size() <= diagram) {
@@ -246,6 +330,19 @@ Monitor::getDisplayName()
     return sname;
 }
 
+double
+Monitor::elapsedSeconds(gint64& previousUs, int refreshRate)
+{
+    gint64 actual_time = g_get_monotonic_time();    // the promise is this does not get screwed up by time adjustments
+    gint64 delta_us = actual_time - previousUs;
+    if (previousUs == 0
+     || delta_us <= 0) {
+        delta_us = static_cast<gint64>(std::max(refreshRate, 1)) * 1000l;
+    }
+    previousUs = actual_time;
+    return static_cast<double>(delta_us) / 1.0E6;
+}
+
 // move to StringUtils unify with Picnic
 std::string
 Monitor::formatScale(double value, const char *suffix, uint64_t scaleFactor)
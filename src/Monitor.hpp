@@ -25,6 +25,8 @@
 #include "Geom2.hpp"
 #include "Page.hpp"
 #include "Buffer.hpp"
+#include "TierHistory.hpp"
+#include "HistoryFile.hpp"
 
 class MonglView;
 
@@ -55,6 +57,7 @@ public:
     Monitor(guint points, const char *_name);
     virtual ~Monitor();
 
+    // refreshRate is the update interval in ms, the rates shoud use the measured time
     virtual gboolean update(int refreshRate, glibtop * glibtop) = 0;
 
     virtual void load_settings(const Glib::KeyFile * setting) = 0;
@@ -72,6 +75,11 @@ public:
 
     unsigned int getNumDiagram() const;
     std::shared_ptr<Buffer<double>> getValues(unsigned int diagram);
+    // keep the history in file (nullptr to not keep it), the values are restored from it,
+    //   call before the first update, file has to outlive the monitor
+    void setHistoryFile(HistoryFile* file);
+    // the values consolidated to tier (raw copies the values above) into buffer of getSize()
+    virtual void getValues(unsigned int diagram, TierHistory::Tier tier, TierHistory::Stat stat, Buffer<double>& buffer);
     virtual Gdk::RGBA *getColor(unsigned int diagram);
     virtual unsigned long getTotal() = 0;
     virtual std::string getPrimMax() = 0;
@@ -80,6 +88,21 @@ public:
     static void add_widget2box(Gtk::Box *dest, const char *lbl, Gtk::Widget *toAdd, gfloat y_scale);
     virtual void close();
     virtual guint defaultValues();  // number of values used by default
+    // update needs the gl context, so it can't be called by the sampler thread
+    virtual bool isGlBound() const {
+        return false;
+    }
+    // update uses the disk stats, so these have to be read before
+    virtual bool isDiskStatBound() const {
+        return false;
+    }
+    // ms between updates this monitor needs (rounded up to the update interval),
+    //   0 updates on every interval (the config key updateTicks overrides this)
+    virtual guint getPreferredPeriod() const {
+        return 0u;
+    }
+    // the seconds since the previous call, the interval for the first
+    static double elapsedSeconds(gint64& previousUs, int refreshRate);
 
     guint getSize() {
         return m_size;
@@ -95,6 +118,17 @@ protected:
     gboolean m_enabled;
     guint m_size;       // number of values
     std::vector<std::shared_ptr<Buffer<double>>> m_Stats;
+    // add the values of the last update to the tiers, called by roll
+    virtual void consolidate(gint64 sampleUs);
+    // add value to the tiers and history file
+    void record(unsigned int diagram, double value, gint64 sampleUs);
+    // set the values from the history file
+    virtual void restore(unsigned int diagram, const HistoryRegion& region);
+    TierHistory& getTiers(unsigned int diagram);
+    std::vector<std::unique_ptr<TierHistory>> m_tiers;     // for each of m_Stats
+    std::vector<HistoryRegion> m_regions;   // for each of m_tiers if a file is used
+    HistoryFile* m_historyFile{nullptr};
+    gint64 m_sampleTime{0l};              // us real time of the last update (as the file may keep the tiers), 0 before the first
 
     Glib::ustring m_device;
     Glib::ustring m_used_device;
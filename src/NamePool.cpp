@@ -0,0 +1,154 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <unistd.h>
+#include <sys/types.h>
+#include <pwd.h>
+#include <grp.h>
+#include <memory>
+#include <mutex>
+#include <vector>
+#include <unordered_map>
+
+#include "NamePool.hpp"
+
+namespace {
+
+struct Pool
+{
+    std::mutex mutex;
+    // keyed by a view of the pooled string, removed by the last reference
+    std::unordered_map<std::string_view, std::weak_ptr<const std::string>> names;
+    std::unordered_map<uint32_t, std::string> users;    // node based, so references are stable
+    std::unordered_map<uint32_t, std::string> groups;
+};
+
+Pool&
+pool()
+{
+    static Pool* instance{new Pool};    // not destroyed, names may be released on exit
+    return *instance;
+}
+
+void
+release(const std::string* name)
+{
+    auto& p = pool();
+    {
+        std::lock_guard<std::mutex> lock(p.mutex);
+        auto entry = p.names.find(*name);
+        if (entry != p.names.end()
+         && entry->first.data() == name->data()) {     // not replaced by an intern meanwhile
+            p.names.erase(entry);
+        }
+    }
+    delete name;
+}
+
+size_t
+bufferSize(int name)
+{
+    long size = sysconf(name);
+    return size > 0 ? static_cast<size_t>(size) : 16384u;
+}
+
+std::string
+lookupUser(uint32_t uid)
+{
+    std::vector<char> buf(bufferSize(_SC_GETPW_R_SIZE_MAX));
+    struct passwd pwd;
+    struct passwd *result{};
+    std::string name;
+    if (getpwuid_r(uid, &pwd, buf.data(), buf.size(), &result) == 0
+     && result != nullptr) {
+        name = result->pw_name;
+    }
+    return name;
+}
+
+std::string
+lookupGroup(uint32_t gid)
+{
+    std::vector<char> buf(bufferSize(_SC_GETGR_R_SIZE_MAX));
+    struct group grp;
+    struct group *result{};
+    std::string name;
+    if (getgrgid_r(gid, &grp, buf.data(), buf.size(), &result) == 0
+     && result != nullptr) {
+        name = result->gr_name;
+    }
+    return name;
+}
+
+}
+
+NamePool::Name
+NamePool::intern(std::string_view name)
+{
+    auto& p = pool();
+    std::lock_guard<std::mutex> lock(p.mutex);
+    auto entry = p.names.find(name);
+    if (entry != p.names.end()) {
+        if (auto shared = entry->second.lock()) {
+            return shared;
+        }
+        p.names.erase(entry);   // the last reference is gone, its release waits for the lock
+    }
+    Name shared{new std::string(name), release};
+    p.names.emplace(std::string_view{*shared}, shared);
+    return shared;
+}
+
+const std::string&
+NamePool::userName(uint32_t uid)
+{
+    auto& p = pool();
+    {
+        std::lock_guard<std::mutex> lock(p.mutex);
+        auto entry = p.users.find(uid);
+        if (entry != p.users.end()) {
+            return entry->second;
+        }
+    }
+    std::string name{lookupUser(uid)};
+    std::lock_guard<std::mutex> lock(p.mutex);
+    return p.users.emplace(uid, std::move(name)).first->second;    // keeps the first if resolved concurrently
+}
+
+const std::string&
+NamePool::groupName(uint32_t gid)
+{
+    auto& p = pool();
+    {
+        std::lock_guard<std::mutex> lock(p.mutex);
+        auto entry = p.groups.find(gid);
+        if (entry != p.groups.end()) {
+            return entry->second;
+        }
+    }
+    std::string name{lookupGroup(gid)};
+    std::lock_guard<std::mutex> lock(p.mutex);
+    return p.groups.emplace(gid, std::move(name)).first->second;
+}
+
+const NamePool::Name&
+NamePool::empty()
+{
+    static const Name emptyName{intern(std::string_view{})};
+    return emptyName;
+}
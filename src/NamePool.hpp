@@ -0,0 +1,43 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+#include <cstdint>
+
+// the names shared by all processes, each distinct name is kept once.
+//   Command names come and go (e.g. scripts with generated names),
+//   so these are reference counted, the last holder removes the entry.
+//   User and group names are bounded by the accounts, these are kept
+//   and the returned references stay valid.
+//   Processes are created by the scan threads, so this is locked,
+//   but only called on creation/exec.
+class NamePool
+{
+public:
+    using Name = std::shared_ptr<const std::string>;
+
+    static Name intern(std::string_view name);
+    // resolved on first use (outside the lock, as nss may block), empty if unknown
+    static const std::string& userName(uint32_t uid);
+    static const std::string& groupName(uint32_t gid);
+    static const Name& empty();
+};
@@ -87,10 +87,13 @@ NetMonitor::reinit()
 
 
 void
-NetMonitor::net_device_changed(Gtk::Entry *device_entry)
+NetMonitor::net_device_changed(Gtk::Entry *device_entry, MonglView *monglView)
 {
-    m_device = device_entry->get_text();
-    reinit();
+    Glib::ustring device = device_entry->get_text();
+    monglView->changeCollectors([this, device] {
+        m_device = device;
+        reinit();
+    });
 }
 
 
@@ -106,9 +109,9 @@ NetMonitor::create_config_page(MonglView *monglView)
     device_entry->set_text(m_device);
     add_widget2box(net_box, _("Device (.e.g eth0 or enp4s0)"), device_entry, 1.0f);
     device_entry->signal_changed().connect(
-	sigc::bind<Gtk::Entry *>(
+	sigc::bind<Gtk::Entry *, MonglView *>(
 	    sigc::mem_fun(*this, &NetMonitor::net_device_changed),
-	device_entry));
+	device_entry, monglView));
 
     auto showNetConnect = Gtk::manage(new Gtk::CheckButton());
     auto config = monglView->getConfig();
@@ -229,11 +232,11 @@ NetMonitor::update(int refreshRate, glibtop * glibtop)
         {
             gint64 delta_us = (actual_time - previous_time);
             if (delta_us == 0)                       // shoud hardly happen but just to be safe
-                delta_us = refreshRate * 1E6;
+                delta_us = refreshRate * 1E3;
             delta_s = 1.0E6/(double)delta_us;        // factor that converts to byte/s
         }
         else
-            delta_s = 1.0/(double)refreshRate;
+            delta_s = 1.0E3/(double)refreshRate;
 
         previous_time = actual_time;
 
@@ -256,33 +259,17 @@ NetMonitor::getTotal()
 }
 
 void
-NetMonitor::updateG15(Cairo::RefPtr<Cairo::Context> cr, guint width, guint height)
+NetMonitor::fillG15(G15Frame& frame)
 {
     double fmax = MAX(m_primaryHist.getMax(), m_secondaryHist.getMax());
 
-    cr->move_to(1.0, 10.0);
-    cr->show_text("Net");
-    std::string total = formatScale(fmax, "B/s");
-    cr->move_to(1.0, 20.0);
-    cr->show_text(m_used_device);
-    cr->move_to(1.0, 30.0);
-    cr->show_text(total);
-
-    cr->rectangle(60.5, 0.5, width-61, height-1);
-    cr->stroke();
-    double x = width - 1.5;
-    for (int i = m_size-1; i >= 0; --i)
-    {
-        cr->move_to(x, height-1);
-        float y = (float)(height-1) - ((MAX(getValues(0)->get(i), getValues(1)->get(i)))*(gfloat)(height-2));
-        cr->line_to(x, y);
-        x -= 1.0;
-        if (x <= 60.0) {
-            break;
-        }
+    frame.lines.push_back("Net");
+    frame.lines.push_back(m_used_device);
+    frame.lines.push_back(formatScale(fmax, "B/s"));
+    frame.framed = true;
+    for (guint i = 0; i < m_size; ++i) {
+        frame.values.push_back(MAX(getValues(0)->get(i), getValues(1)->get(i)));
     }
-    cr->stroke();
-
 }
 
 void
@@ -39,9 +39,9 @@ public:
     std::string getPrimMax() override;
     std::string getSecMax() override;
 
-    void updateG15(Cairo::RefPtr<Cairo::Context> cr, guint width, guint height) override;
+    void fillG15(G15Frame& frame) override;
 private:
-    void net_device_changed(Gtk::Entry *device_entry) ;
+    void net_device_changed(Gtk::Entry *device_entry, MonglView *monglView) ;
     
     static constexpr auto CONFIG_DISPLAY_NET = "DisplayNET";
     static constexpr auto CONFIG_NET_COLOR = "NETColor";
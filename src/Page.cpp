@@ -20,3 +20,49 @@
 Page::Page()
 {
 }
+
+void
+Page::publishG15()
+{
+    auto& frame = m_g15.back();
+    frame.clear();
+    fillG15(frame);
+    m_g15.publish();
+}
+
+void
+Page::fillG15(G15Frame& frame)
+{
+}
+
+void
+Page::updateG15(Cairo::RefPtr<Cairo::Context> cr, guint width, guint height)
+{
+    auto& frame = m_g15.front();
+    double y = 10.0;
+    for (auto& line : frame.lines) {
+        cr->move_to(1.0, y);
+        cr->show_text(line);
+        y += 10.0;
+        if (y > height) {
+            break;
+        }
+    }
+    if (frame.framed) {
+        cr->rectangle(60.5, 0.5, width-61, height-1);
+        cr->stroke();
+    }
+    if (!frame.values.empty()) {
+        double x = width - 1.5;
+        for (auto i = frame.values.rbegin(); i != frame.values.rend(); ++i) {
+            cr->move_to(x, height-1);
+            double v = (height-1) - *i * (height-2);
+            cr->line_to(x, v);
+            x -= 1.0;
+            if (x <= 60.0) {
+                break;
+            }
+        }
+        cr->stroke();
+    }
+}
@@ -18,6 +18,26 @@
 #pragma once
 
 #include <gtkmm.h>
+#include <string>
+#include <vector>
+
+#include "TripleBuffer.hpp"
+
+// what a page shows on the G15, a few lines of text
+//   and optional a graph right of them
+struct G15Frame
+{
+    std::vector<std::string> lines;
+    bool framed{false};             // draw the box of the graph
+    std::vector<double> values;     // graph 0..1, the latest last
+
+    void clear()
+    {
+        lines.clear();
+        framed = false;
+        values.clear();
+    }
+};
 
 class Page
 {
@@ -26,10 +46,16 @@ public:
     explicit Page(const Page& orig) = delete;
     virtual ~Page() = default;
 
+    // called by the update (gtk) thread after the page changed,
+    //   hands a copy of the state to the G15 worker
+    void publishG15();
     // the cairo font rendering is called a play function and as that leads to different outlines
     //    as the string gets longer -> the FT_Bitmap_ and pango_ft2_render might be an alterantive
-    virtual void updateG15(Cairo::RefPtr<Cairo::Context> cr, guint width, guint height) = 0;
+    //  called by the G15 worker, by default draws the last published frame
+    virtual void updateG15(Cairo::RefPtr<Cairo::Context> cr, guint width, guint height);
+protected:
+    // called by publishG15 with a cleared frame
+    virtual void fillG15(G15Frame& frame);
 private:
-
+    TripleBuffer<G15Frame> m_g15;
 };
-
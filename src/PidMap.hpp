@@ -0,0 +1,203 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <vector>
+#include <cstdint>
+
+// a map pid -> value, the values are kept dense in a vector
+//   (iteration is a linear walk, erase moves the last value into the gap),
+//   lookups use a open addressing table of pid/index pairs with linear probing,
+//   so a find only touches the table and not the values.
+//   The values are expected to be handles (e.g. shared_ptr) these stay valid on changes,
+//   but any reference into the map is invalidated by insert/erase.
+template<typename V>
+class PidMap
+{
+public:
+    PidMap()
+    {
+        m_slots.resize(MIN_SLOTS);
+    }
+    explicit PidMap(const PidMap& orig) = delete;
+    virtual ~PidMap() = default;
+
+    // returns nullptr if not found, the pointer is valid until the next insert/erase
+    V* find(pid_t pid)
+    {
+        auto slot = findSlot(pid);
+        return slot != NOT_FOUND ? &m_values[m_slots[slot].index] : nullptr;
+    }
+    const V* find(pid_t pid) const
+    {
+        auto slot = findSlot(pid);
+        return slot != NOT_FOUND ? &m_values[m_slots[slot].index] : nullptr;
+    }
+    bool contains(pid_t pid) const
+    {
+        return findSlot(pid) != NOT_FOUND;
+    }
+    // returns false if the pid exists (the value is kept)
+    bool insert(pid_t pid, const V& value)
+    {
+        if ((m_values.size() + 1u) * 2u > m_slots.size()) {   // keep load below 1/2, probing stays short
+            rehash(m_slots.size() * 2u);
+        }
+        size_t slot = home(pid);
+        while (m_slots[slot].pid != EMPTY) {
+            if (m_slots[slot].pid == pid) {
+                return false;
+            }
+            slot = (slot + 1u) & mask();
+        }
+        m_slots[slot] = Slot{pid, static_cast<uint32_t>(m_values.size())};
+        m_pids.push_back(pid);
+        m_values.push_back(value);
+        return true;
+    }
+    bool erase(pid_t pid)
+    {
+        auto slot = findSlot(pid);
+        if (slot == NOT_FOUND) {
+            return false;
+        }
+        eraseAt(slot);
+        return true;
+    }
+    // erase all values the predicate is true for, as erasing while iterating is not supported
+    template<typename Pred>
+    size_t eraseIf(Pred pred)
+    {
+        size_t erased{};
+        for (size_t i = 0; i < m_values.size(); ) {
+            if (pred(m_values[i])) {
+                eraseAt(findSlot(m_pids[i]));   // the last is moved to i, so check i again
+                ++erased;
+            }
+            else {
+                ++i;
+            }
+        }
+        return erased;
+    }
+    void clear()
+    {
+        m_values.clear();
+        m_pids.clear();
+        m_slots.assign(MIN_SLOTS, Slot{});
+    }
+    size_t size() const
+    {
+        return m_values.size();
+    }
+    bool empty() const
+    {
+        return m_values.empty();
+    }
+    // the values in no specific order
+    auto begin()
+    {
+        return m_values.begin();
+    }
+    auto end()
+    {
+        return m_values.end();
+    }
+    auto begin() const
+    {
+        return m_values.begin();
+    }
+    auto end() const
+    {
+        return m_values.end();
+    }
+
+    static constexpr size_t MIN_SLOTS{64u};
+private:
+    struct Slot
+    {
+        pid_t pid{EMPTY};
+        uint32_t index{};
+    };
+    static constexpr pid_t EMPTY{0};    // no process uses pid 0
+    static constexpr size_t NOT_FOUND{SIZE_MAX};
+
+    size_t mask() const
+    {
+        return m_slots.size() - 1u;
+    }
+    size_t home(pid_t pid) const
+    {
+        // fibonacci hashing, pids are mostly sequential, spread them
+        auto hash = static_cast<uint64_t>(static_cast<uint32_t>(pid)) * 0x9E3779B97F4A7C15ull;
+        return static_cast<size_t>(hash >> 32u) & mask();
+    }
+    size_t findSlot(pid_t pid) const
+    {
+        size_t slot = home(pid);
+        while (m_slots[slot].pid != EMPTY) {
+            if (m_slots[slot].pid == pid) {
+                return slot;
+            }
+            slot = (slot + 1u) & mask();
+        }
+        return NOT_FOUND;
+    }
+    void eraseAt(size_t slot)
+    {
+        uint32_t index = m_slots[slot].index;
+        uint32_t last = static_cast<uint32_t>(m_values.size() - 1u);
+        if (index != last) {    // fill the gap with the last value
+            m_slots[findSlot(m_pids[last])].index = index;
+            m_values[index] = std::move(m_values[last]);
+            m_pids[index] = m_pids[last];
+        }
+        m_values.pop_back();
+        m_pids.pop_back();
+        // backward shift the following entries, so no tombstones are needed
+        size_t hole = slot;
+        size_t next = (hole + 1u) & mask();
+        while (m_slots[next].pid != EMPTY) {
+            size_t want = home(m_slots[next].pid);
+            // move if the wanted position is not in the (cyclic) range (hole, next]
+            if (((next - want) & mask()) >= ((next - hole) & mask())) {
+                m_slots[hole] = m_slots[next];
+                hole = next;
+            }
+            next = (next + 1u) & mask();
+        }
+        m_slots[hole] = Slot{};
+    }
+    void rehash(size_t slots)
+    {
+        m_slots.assign(slots, Slot{});
+        for (uint32_t i = 0; i < m_pids.size(); ++i) {
+            size_t slot = home(m_pids[i]);
+            while (m_slots[slot].pid != EMPTY) {
+                slot = (slot + 1u) & mask();
+            }
+            m_slots[slot] = Slot{m_pids[i], i};
+        }
+    }
+
+    std::vector<Slot> m_slots;      // power of 2 size
+    std::vector<pid_t> m_pids;      // parallel to values, to find the slot of a value
+    std::vector<V> m_values;
+};
@@ -0,0 +1,91 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <dirent.h>
+#include <sys/syscall.h>
+#include <cstddef>
+#include <algorithm>
+
+#include "PidScanner.hpp"
+
+// the layout the kernel uses for getdents64 (glibc < 2.30 has no declaration),
+//   as dirent64 these are only accessed by pointer
+struct linux_dirent64
+{
+    ino64_t        d_ino;
+    off64_t        d_off;
+    unsigned short d_reclen;
+    unsigned char  d_type;
+    char           d_name[256];   // same as dirent, the actual length is given by reclen
+};
+
+PidScanner::PidScanner(size_t bufferSize)
+: m_buf(bufferSize)
+, m_error{0}
+{
+}
+
+bool
+PidScanner::scan(const char* dir, std::vector<pid_t>& pids)
+{
+    pids.clear();
+    m_error = 0;
+    int fd = open(dir, O_RDONLY | O_DIRECTORY | O_CLOEXEC);
+    if (fd < 0) {
+        m_error = errno;
+        return false;
+    }
+    bool sorted = true;
+    pid_t last{};
+    while (true) {
+        long len = syscall(SYS_getdents64, fd, m_buf.data(), m_buf.size());
+        if (len < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            m_error = errno;
+            break;
+        }
+        if (len == 0) {
+            break;
+        }
+        for (long pos = 0; pos < len; ) {
+            auto ent = reinterpret_cast<const linux_dirent64*>(m_buf.data() + pos);
+            pos += ent->d_reclen;
+            // the first character rejects most of the non-process entries
+            if (static_cast<uint32_t>(static_cast<unsigned char>(ent->d_name[0])) - static_cast<uint32_t>('0') > 9u
+             || (ent->d_type != DT_DIR && ent->d_type != DT_UNKNOWN)) {
+                continue;
+            }
+            pid_t pid = parsePid(ent->d_name);
+            if (pid > 0) {
+                sorted &= pid > last;
+                last = pid;
+                pids.push_back(pid);
+            }
+        }
+    }
+    close(fd);
+    if (!sorted) {  // /proc lists ascending, but we can't rely on this e.g. for other filesystems
+        std::sort(pids.begin(), pids.end());
+    }
+    return m_error == 0;
+}
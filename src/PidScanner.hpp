@@ -0,0 +1,60 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <vector>
+#include <cstdint>
+
+// lists the numeric entries of /proc (or a directory built alike)
+//   with getdents64 into a buffer that is reused for each scan,
+//   this saves the per entry call and conversion of readdir/atol.
+//   The pids are returned in ascending order, so parents
+//   are usually listed before their children.
+class PidScanner
+{
+public:
+    PidScanner(size_t bufferSize = BUFFER_SIZE);
+    explicit PidScanner(const PidScanner& orig) = delete;
+    virtual ~PidScanner() = default;
+
+    // fills pids with the directory entries that are all digits, on false see getError for errno
+    bool scan(const char* dir, std::vector<pid_t>& pids);
+    int getError() const
+    {
+        return m_error;
+    }
+    // parse a entry name, returns 0 if it contains anything but digits
+    static pid_t parsePid(const char* name)
+    {
+        uint32_t pid{};
+        uint32_t other{};
+        for (; *name != '\0'; ++name) {
+            uint32_t digit = static_cast<uint32_t>(static_cast<unsigned char>(*name)) - static_cast<uint32_t>('0');
+            other |= static_cast<uint32_t>(digit > 9u);   // collect, instead of a exit per character
+            pid = pid * 10u + digit;
+        }
+        return other ? 0 : static_cast<pid_t>(pid);
+    }
+
+    static constexpr size_t BUFFER_SIZE{32u * 1024u};
+private:
+    std::vector<char> m_buf;
+    int m_error;
+};
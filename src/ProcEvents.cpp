@@ -0,0 +1,137 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sys/socket.h>
+#include <unistd.h>
+#include <errno.h>
+#include <cstring>
+#include <linux/netlink.h>
+#include <linux/connector.h>
+#include <linux/cn_proc.h>
+
+#include "ProcEvents.hpp"
+
+NetlinkProcEvents::NetlinkProcEvents()
+: m_socket{-1}
+, m_error{0}
+, m_buf(BUFFER_SIZE)
+{
+    m_socket = socket(PF_NETLINK, SOCK_DGRAM | SOCK_NONBLOCK | SOCK_CLOEXEC, NETLINK_CONNECTOR);
+    if (m_socket < 0) {
+        m_error = errno;
+        return;
+    }
+    struct sockaddr_nl addr{};
+    addr.nl_family = AF_NETLINK;
+    addr.nl_groups = CN_IDX_PROC;
+    addr.nl_pid = 0;    // let the kernel assign
+    if (bind(m_socket, reinterpret_cast<struct sockaddr*>(&addr), sizeof(addr)) < 0
+     || !subscribe(true)) {
+        if (m_error == 0) {
+            m_error = errno;
+        }
+        close(m_socket);
+        m_socket = -1;
+    }
+}
+
+NetlinkProcEvents::~NetlinkProcEvents()
+{
+    if (m_socket >= 0) {
+        subscribe(false);
+        close(m_socket);
+    }
+}
+
+bool
+NetlinkProcEvents::subscribe(bool listen)
+{
+    // nlmsghdr, cn_msg, op in sequence (cn_msg ends with a flexible array so no struct for all)
+    alignas(struct nlmsghdr) char request[NLMSG_LENGTH(sizeof(struct cn_msg) + sizeof(enum proc_cn_mcast_op))]{};
+    auto hdr = reinterpret_cast<struct nlmsghdr*>(request);
+    hdr->nlmsg_len = sizeof(request);
+    hdr->nlmsg_type = NLMSG_DONE;
+    hdr->nlmsg_pid = static_cast<__u32>(getpid());
+    auto msg = static_cast<struct cn_msg*>(NLMSG_DATA(hdr));
+    msg->id.idx = CN_IDX_PROC;
+    msg->id.val = CN_VAL_PROC;
+    msg->len = sizeof(enum proc_cn_mcast_op);
+    enum proc_cn_mcast_op op = listen ? PROC_CN_MCAST_LISTEN : PROC_CN_MCAST_IGNORE;
+    std::memcpy(msg->data, &op, sizeof(op));
+    if (send(m_socket, request, sizeof(request), 0) < 0) {
+        m_error = errno;
+        return false;
+    }
+    return true;
+}
+
+bool
+NetlinkProcEvents::read(std::vector<ProcEvent>& events)
+{
+    if (m_socket < 0) {
+        return false;
+    }
+    bool complete = true;
+    while (true) {
+        ssize_t len = recv(m_socket, m_buf.data(), m_buf.size(), 0);
+        if (len < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            if (errno == ENOBUFS) {     // the socket buffer overran, events are lost
+                complete = false;
+                continue;
+            }
+            break;  // EAGAIN, nothing more for now
+        }
+        for (auto hdr = reinterpret_cast<struct nlmsghdr*>(m_buf.data());
+             NLMSG_OK(hdr, static_cast<size_t>(len));
+             hdr = NLMSG_NEXT(hdr, len)) {
+            if (hdr->nlmsg_type == NLMSG_ERROR
+             || hdr->nlmsg_type == NLMSG_OVERRUN) {
+                complete = false;
+                continue;
+            }
+            auto msg = static_cast<struct cn_msg*>(NLMSG_DATA(hdr));
+            if (msg->id.idx != CN_IDX_PROC
+             || msg->id.val != CN_VAL_PROC
+             || msg->len < sizeof(struct proc_event)) {
+                continue;
+            }
+            auto ev = reinterpret_cast<struct proc_event*>(msg->data);
+            switch (ev->what) {
+            case proc_event::PROC_EVENT_FORK:
+                if (ev->event_data.fork.child_pid == ev->event_data.fork.child_tgid) {    // ignore threads
+                    events.push_back(ProcEvent{ProcEvent::Type::Fork, ev->event_data.fork.child_tgid, ev->event_data.fork.parent_tgid});
+                }
+                break;
+            case proc_event::PROC_EVENT_EXEC:
+                events.push_back(ProcEvent{ProcEvent::Type::Exec, ev->event_data.exec.process_tgid, 0});
+                break;
+            case proc_event::PROC_EVENT_EXIT:
+                if (ev->event_data.exit.process_pid == ev->event_data.exit.process_tgid) {
+                    events.push_back(ProcEvent{ProcEvent::Type::Exit, ev->event_data.exit.process_tgid, 0});
+                }
+                break;
+            default:
+                break;
+            }
+        }
+    }
+    return complete;
+}
@@ -0,0 +1,82 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <vector>
+#include <cstdint>
+
+// a process event as far as the process list is concerned,
+//   threads are not reported
+struct ProcEvent
+{
+    enum class Type {
+        Fork,
+        Exec,
+        Exit
+    };
+    Type type;
+    pid_t pid;
+    pid_t ppid;     // only set for fork
+};
+
+// source of process fork/exec/exit events,
+//   allows to update the process list without listing /proc
+class ProcEventSource
+{
+public:
+    ProcEventSource() = default;
+    explicit ProcEventSource(const ProcEventSource& orig) = delete;
+    virtual ~ProcEventSource() = default;
+
+    // false if no events will be delivered (e.g. missing permission)
+    virtual bool isConnected() const = 0;
+    // append the events since the last call without blocking,
+    //   returns false if events were lost, so a full scan is required
+    virtual bool read(std::vector<ProcEvent>& events) = 0;
+};
+
+// the events of the kernel process connector (cn_proc),
+//   requires CAP_NET_ADMIN to subscribe
+class NetlinkProcEvents
+: public ProcEventSource
+{
+public:
+    NetlinkProcEvents();
+    explicit NetlinkProcEvents(const NetlinkProcEvents& orig) = delete;
+    virtual ~NetlinkProcEvents();
+
+    bool isConnected() const override
+    {
+        return m_socket >= 0;
+    }
+    bool read(std::vector<ProcEvent>& events) override;
+    // the errno if not connected
+    int getError() const
+    {
+        return m_error;
+    }
+private:
+    bool subscribe(bool listen);
+
+    int m_socket;
+    int m_error;
+    std::vector<char> m_buf;
+    static constexpr size_t BUFFER_SIZE{16u * 1024u};
+};
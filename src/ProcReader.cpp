@@ -0,0 +1,91 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <cstring>
+
+#include "ProcReader.hpp"
+
+ProcReader::ProcReader(size_t initialSize)
+: m_buf(initialSize)
+, m_len{0u}
+, m_error{0}
+{
+}
+
+bool
+ProcReader::read(const char* name)
+{
+    m_len = 0u;
+    int fd = open(name, O_RDONLY | O_CLOEXEC);
+    if (fd < 0) {
+        m_error = errno;
+        return false;
+    }
+    bool ret = readFd(fd);
+    close(fd);
+    return ret;
+}
+
+bool
+ProcReader::read(const std::string& name)
+{
+    return read(name.c_str());
+}
+
+bool
+ProcReader::read(int fd)
+{
+    m_len = 0u;
+    return readFd(fd);
+}
+
+bool
+ProcReader::readFd(int fd)
+{
+    m_error = 0;
+    while (true) {
+        if (m_len >= m_buf.size()) {    // proc files report size 0 so we have to find out by reading
+            m_buf.resize(m_buf.size() * 2u);
+        }
+        size_t avail = m_buf.size() - m_len;
+        ssize_t len = pread(fd, m_buf.data() + m_len, avail, static_cast<off_t>(m_len));
+        if (len < 0) {
+            if (errno == EINTR) {
+                continue;
+            }
+            m_error = errno;
+            m_len = 0u;
+            return false;
+        }
+        m_len += static_cast<size_t>(len);
+        if (static_cast<size_t>(len) < avail) {   // a short read means we are done, saves the extra call to see eof
+            break;
+        }
+    }
+    return true;
+}
+
+const char*
+ProcReader::lineEnd(const char* pos, const char* end)
+{
+    auto nl = static_cast<const char*>(std::memchr(pos, '\n', static_cast<size_t>(end - pos)));
+    return nl != nullptr ? nl : end;
+}
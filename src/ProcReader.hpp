@@ -0,0 +1,105 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+// reads small (proc-)files into a reusable buffer,
+//   one reader is intended per scanning thread
+//   so the buffer is reused for all processes.
+//   The scan functions work on the buffer without copying,
+//   and return the position after the scanned value.
+class ProcReader
+{
+public:
+    ProcReader(size_t initialSize = INITIAL_SIZE);
+    explicit ProcReader(const ProcReader& orig) = delete;
+    virtual ~ProcReader() = default;
+
+    // read the whole file, on false see getError for errno
+    bool read(const char* name);
+    bool read(const std::string& name);
+    // read from start of a already opened file (pread)
+    bool read(int fd);
+    const char* begin() const
+    {
+        return m_buf.data();
+    }
+    const char* end() const
+    {
+        return m_buf.data() + m_len;
+    }
+    size_t length() const
+    {
+        return m_len;
+    }
+    int getError() const
+    {
+        return m_error;
+    }
+
+    static const char* skipSpace(const char* pos, const char* end)
+    {
+        while (pos < end && (*pos == ' ' || *pos == '\t')) {
+            ++pos;
+        }
+        return pos;
+    }
+    // same as >> does skip leading space, sets 0 if nothing was found
+    static const char* scanUnsigned(const char* pos, const char* end, uint64_t& val)
+    {
+        pos = skipSpace(pos, end);
+        uint64_t ret{};
+        while (pos < end) {
+            uint32_t digit = static_cast<uint32_t>(*pos) - static_cast<uint32_t>('0');
+            if (digit > 9u) {
+                break;
+            }
+            ret = ret * 10u + digit;
+            ++pos;
+        }
+        val = ret;
+        return pos;
+    }
+    static const char* scanSigned(const char* pos, const char* end, int64_t& val)
+    {
+        pos = skipSpace(pos, end);
+        bool negative = false;
+        if (pos < end && *pos == '-') {
+            negative = true;
+            ++pos;
+        }
+        uint64_t uval;
+        pos = scanUnsigned(pos, end, uval);
+        val = negative ? -static_cast<int64_t>(uval) : static_cast<int64_t>(uval);
+        return pos;
+    }
+    // returns the end of the actual line (without the newline)
+    static const char* lineEnd(const char* pos, const char* end);
+
+    static constexpr size_t INITIAL_SIZE{4096u};
+private:
+    bool readFd(int fd);
+
+    std::vector<char> m_buf;
+    size_t m_len;
+    int m_error;
+};
@@ -16,13 +16,18 @@
  */
 
 #include <string.h>
+#include <cstring>
 #include <string>
+#include <string_view>
 #include <iostream>
 #include <fstream>
 #include <gtkmm.h>
 #include <stdlib.h>
 #include <sys/types.h>
 #include <signal.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <errno.h>
 #include <Log.hpp>
 #include <StringUtils.hpp>
 
@@ -30,16 +35,23 @@
 #include "Monitor.hpp"
 #include "NameValue.hpp"
 
-Process::Process(std::string _path, long _pid, guint _size)
+Process::Process(std::string _path, long _pid, const pProcessHistory& history)
 : psc::gl::TreeNode2::TreeNode2()
 , stage{psc::gl::TreeNodeState::New}
 , path{std::move(_path)}
+, m_statPath{path + "/stat"}
+, m_statusPath{path + "/status"}
+, m_ioPath{path + "/io"}
+, m_keepOpen{false}
+, m_statFd{-1}
+, m_statusFd{-1}
+, m_linkedPpid{-1}
 , lastCpuTime{0l}
-, m_size{_size}
-, data_cpu{std::make_shared<Buffer<double>>(_size)}
-, data_mem{std::make_shared<Buffer<double>>(_size)}
+, m_history{history}
+, m_historyIndex{ProcessHistory::NO_INDEX}
 , cpuTime{0}
 , pid{0}
+, m_name{NamePool::empty()}
 , state{'?'}
 , ppid{0}
 , vmPeakK{0}
@@ -74,15 +86,57 @@ Process::Process(std::string _path, long _pid, guint _size)
 , rss{0}
 , rsslim{0}
 , m_load{0.0}
+, m_collectIo{false}
+, m_ioDenied{false}
+, m_ioReadBytes{0}
+, m_ioWriteBytes{0}
+, m_ioDelta{0}
+, m_voluntaryCtxt{0}
+, m_nonvoluntaryCtxt{0}
+, m_ctxtDelta{0}
+, m_pssK{0}
+, m_ussK{0}
+, m_swapK{0}
+, m_idleCadence{0u}
+, m_idleTicks{0u}
+, m_skippedTicks{0u}
+, m_deltaTicks{1u}
+, m_filterMatch{true}
+, m_shown{true}
+, m_comm{}
+, m_identityStale{true}
+, m_identityReads{0u}
+, m_uid{ROOT_UID}
+, m_gid{ROOT_GID}
 {
     pid = _pid;
+    if (m_history) {
+        m_historyIndex = m_history->allocate();
+    }
+}
+
+Process::~Process()
+{
+    setKeepOpen(false);
+    if (m_history) {
+        m_history->release(m_historyIndex);
+    }
 }
 
 void
-Process::roll()
+Process::setKeepOpen(bool keepOpen)
 {
-    data_mem->roll();
-    data_cpu->roll();
+    m_keepOpen = keepOpen;
+    if (!m_keepOpen) {
+        if (m_statFd >= 0) {
+            close(m_statFd);
+            m_statFd = -1;
+        }
+        if (m_statusFd >= 0) {
+            close(m_statusFd);
+            m_statusFd = -1;
+        }
+    }
 }
 
 long
@@ -105,7 +159,7 @@ Process::getCpuUsage()
 unsigned long
 Process::getCpuUsageBuf()
 {
-    return data_cpu->sum();
+    return m_history ? static_cast<unsigned long>(m_history->sum(ProcessHistory::CPU, m_historyIndex)) : 0ul;
 }
 
 float
@@ -123,30 +177,72 @@ Process::getCpuUsageSum()
 }
 
 void
-Process::update()
+Process::update(ProcReader& reader)
 {
     touched = true;
     if (!isActive()) {
         return;
     }
-    update_status();
-    update_stat();
-    // tried to make ../nnn/io stats available but these are not worth the effort as they produce various errors (with already taking the effort to read them at once)
+    const unsigned long prevCpuTime = cpuTime;
+    const unsigned long prevRss = rss;
+    const long prevPpid = stat_ppid;
+    auto unchanged = [&] {
+        return cpuTime == prevCpuTime && rss == prevRss && stat_ppid == prevPpid
+            && !m_identityStale;
+    };
+    if (isIdle()
+     && m_idleTicks % m_idleCadence != 0u) {
+        read_stat(reader);  // the cheap check
+        if (unchanged() || !isActive()) {
+            ++m_idleTicks;
+            ++m_skippedTicks;
+            m_ctxtDelta = 0;    // the status values are carried forward
+            m_ioDelta = 0;
+            m_deltaTicks = 1u;
+            return;
+        }
+        read_status(reader);
+    }
+    else {
+        read_stat(reader);      // first, as it tells if the name needs to be parsed
+        read_status(reader);
+    }
+    if (m_collectIo
+     && !m_ioDenied) {
+        read_io(reader);
+    }
+    // the counters grew over the skipped updates as well, so spread the growth
+    //   (see update(cpu, mem)), otherwise it would show as a spike
+    m_deltaTicks = m_skippedTicks + 1u;
+    m_skippedTicks = 0u;
+    m_ctxtDelta /= m_deltaTicks;
+    m_ioDelta /= m_deltaTicks;
+    m_idleTicks = unchanged() ? m_idleTicks + 1u : 0u;
 }
 
 void
 Process::update(std::shared_ptr<Monitor> cpu, std::shared_ptr<Monitor> mem) {
+    // Show factor of total, the history is rolled for all processes, so set a value in any case
+    //   (a finished process is kept for a while, without values, otherwise its slot would repeat an old value)
+    double memLoad{};
     if (!isActive()) {
-        return;
+        m_load = 0.0;
+        m_ioDelta = 0;
+        m_ctxtDelta = 0;
+        m_deltaTicks = 1u;
     }
-    roll();
-    // Show factor of total
-    if (cpu->getTotal() > 0l) {
-        m_load = (double)getCpuUsage() / (double)cpu->getTotal();
-        data_cpu->set(m_load);
+    else {
+        if (cpu->getTotal() > 0l) {
+            m_load = (double)getCpuUsage() / (double)cpu->getTotal();
+        }
+        if (mem->getTotal() > 0l) {
+            memLoad = (double)getMemGraph() / (double)mem->getTotal();
+        }
     }
-    if (mem->getTotal() > 0l) {
-        data_mem->set((double)getMemGraph() / (double)mem->getTotal());
+    if (m_history) {
+        m_history->set(ProcessHistory::CPU, m_historyIndex, static_cast<float>(m_load));
+        m_history->set(ProcessHistory::MEM, m_historyIndex, static_cast<float>(memLoad));
+        m_history->setRecent(ProcessHistory::IO, m_historyIndex, m_deltaTicks, static_cast<float>(m_ioDelta));
     }
     //std::cout << name << " cpu " << (double)getCpuUsage() << " total " <<  (double)cpu->getTotal() << std::endl;
     //std::cout << name << " mem " <<  (double)getMemUsage() << " total " << (double)mem->getTotal() << std::endl;
@@ -222,7 +318,7 @@ Process::update_status()
 
 	NameValue nameValue;
 	if (nameValue.read(sstat)) {
-		name = nameValue.getString("Name:");
+		m_name = NamePool::intern(nameValue.getString("Name:"));
 		auto sstate = nameValue.getString("State:");
 		state = sstate[0];
 		ppid = nameValue.getUnsigned("PPid:");
@@ -234,6 +330,8 @@ Process::update_status()
 		vmRssK = nameValue.getUnsigned("VmRSS:");
 		rssAnonK = nameValue.getUnsigned("RssAnon:");
 		rssFileK = nameValue.getUnsigned("RssFile:");
+		m_voluntaryCtxt = nameValue.getUnsigned("voluntary_ctxt_switches:");
+		m_nonvoluntaryCtxt = nameValue.getUnsigned("nonvoluntary_ctxt_switches:");
         auto uid = nameValue.getString("Uid:");
         std::vector<Glib::ustring> uids;
         StringUtils::split(uid,'\t', uids);
@@ -258,11 +356,297 @@ Process::update_status()
 	}
 }
 
+bool
+Process::readProc(ProcReader& reader, const std::string& name, int& fd)
+{
+    if (m_keepOpen) {
+        if (fd < 0) {
+            fd = open(name.c_str(), O_RDONLY | O_CLOEXEC);
+        }
+        if (fd >= 0) {
+            return reader.read(fd);
+        }
+    }
+    return reader.read(name);   // will also give the error if open failed
+}
+
+void
+Process::readFailed(ProcReader& reader)
+{
+    auto error = reader.getError();
+    if (m_keepOpen
+     && (error == ESRCH || error == ENOENT)) {
+        touched = false;    // the open file tells us the process has gone, close as if it was not found
+    }
+    else {
+        stage = psc::gl::TreeNodeState::Finished;     // do not ask again
+    }
+}
+
+void
+Process::read_stat(ProcReader& reader)
+{
+    if (readProc(reader, m_statPath, m_statFd)) {
+        const char* end = reader.end();
+        const char* pos = end;
+        while (pos > reader.begin() && *(pos - 1) != ')') {    // name may contain spaces and braces, so search from the end
+            --pos;
+        }
+        if (pos > reader.begin()) {
+            auto open = static_cast<const char*>(std::memchr(reader.begin(), '(', static_cast<size_t>(pos - reader.begin())));
+            if (open != nullptr) {
+                std::string_view comm(open + 1, static_cast<size_t>(pos - 1 - (open + 1)));
+                if (m_comm == nullptr
+                 || *m_comm != comm) {
+                    m_identityStale = m_identityStale || m_comm != nullptr;   // exec'd (or renamed)
+                    m_comm = NamePool::intern(comm);
+                }
+            }
+            const unsigned long long lastStarttime = starttime;
+            int64_t sval;
+            uint64_t uval;
+            pos = ProcReader::skipSpace(pos, end);
+            if (pos < end) {
+                stat_state = *pos++;
+            }
+            pos = ProcReader::scanSigned(pos, end, sval);
+            stat_ppid = sval;
+            pos = ProcReader::scanSigned(pos, end, sval);
+            pgrp = sval;
+            pos = ProcReader::scanSigned(pos, end, sval);
+            session = sval;
+            pos = ProcReader::scanSigned(pos, end, sval);
+            tty_nr = sval;
+            pos = ProcReader::scanSigned(pos, end, sval);
+            tpgid = sval;
+            pos = ProcReader::scanUnsigned(pos, end, uval);
+            flags = uval;
+            pos = ProcReader::scanUnsigned(pos, end, uval);
+            minflt = uval;
+            pos = ProcReader::scanUnsigned(pos, end, uval);
+            cminflt = uval;
+            pos = ProcReader::scanUnsigned(pos, end, uval);
+            majflt = uval;
+            pos = ProcReader::scanUnsigned(pos, end, uval);
+            cmajflt = uval;
+            pos = ProcReader::scanUnsigned(pos, end, uval);
+            utime = uval;
+            pos = ProcReader::scanUnsigned(pos, end, uval);
+            stime = uval;
+            pos = ProcReader::scanSigned(pos, end, sval);
+            cutime = sval;
+            pos = ProcReader::scanSigned(pos, end, sval);
+            cstime = sval;
+            pos = ProcReader::scanSigned(pos, end, sval);
+            priority = sval;
+            pos = ProcReader::scanSigned(pos, end, sval);
+            nice = sval;
+            pos = ProcReader::scanSigned(pos, end, sval);
+            num_threads = sval;
+            pos = ProcReader::scanSigned(pos, end, sval);
+            itrealvalue = sval;
+            pos = ProcReader::scanUnsigned(pos, end, uval);
+            starttime = uval;
+            pos = ProcReader::scanUnsigned(pos, end, uval);
+            vsize = uval;
+            pos = ProcReader::scanUnsigned(pos, end, uval);
+            rss = uval;
+            pos = ProcReader::scanUnsigned(pos, end, uval);
+            rsslim = uval;
+            if (lastStarttime != 0ull
+             && lastStarttime != starttime) {
+                m_identityStale = true;     // the pid was reused
+            }
+        }
+    }
+    else {
+        readFailed(reader);
+    }
+    lastCpuTime = cpuTime;
+    cpuTime =  (utime + stime);
+}
+
+// compare the key (including the colon) at the start of line
+static inline bool
+isKey(const char* pos, const char* lineEnd, const char* key, size_t keyLen)
+{
+    return static_cast<size_t>(lineEnd - pos) >= keyLen
+        && std::memcmp(pos, key, keyLen) == 0;
+}
+
+static inline long
+scanStatusUnsigned(const char* pos, const char* lineEnd)
+{
+    uint64_t val;
+    ProcReader::scanUnsigned(pos, lineEnd, val);
+    return static_cast<long>(val);
+}
+
+void
+Process::read_status(ProcReader& reader)
+{
+    if (!readProc(reader, m_statusPath, m_statusFd)) {
+        readFailed(reader);
+        return;
+    }
+    // the identity only changes with exec (see read_stat), check occasionally for setuid
+    const bool identity = m_identityStale || ++m_identityReads >= IDENTITY_REFRESH;
+    bool nameFound{false};
+    // same defaults as if the keys are missing (e.g. kernel threads have no memory)
+    state = '\0';
+    ppid = 0;
+    vmPeakK = 0;
+    vmSizeK = 0;
+    vmDataK = 0;
+    vmStackK = 0;
+    vmExecK = 0;
+    vmRssK = 0;
+    rssAnonK = 0;
+    rssFileK = 0;
+    if (identity) {
+        m_uid = ROOT_UID;
+        m_gid = ROOT_GID;
+    }
+    uint64_t voluntaryCtxt{};
+    uint64_t nonvoluntaryCtxt{};
+    const char* end = reader.end();
+    for (const char* pos = reader.begin(); pos < end; ) {
+        const char* eol = ProcReader::lineEnd(pos, end);
+        switch (*pos) {     // preselect as most lines are not of interest
+        case 'N':
+            if (identity
+             && isKey(pos, eol, "Name:", 5)) {
+                const char* val = ProcReader::skipSpace(pos + 5, eol);
+                const char* valEnd = eol;
+                while (valEnd > val && (*(valEnd - 1) == ' ' || *(valEnd - 1) == '\t')) {
+                    --valEnd;
+                }
+                std::string_view statusName(val, static_cast<size_t>(valEnd - val));
+                if (*m_name != statusName) {
+                    m_name = NamePool::intern(statusName);
+                }
+                nameFound = true;
+            }
+            break;
+        case 'S':
+            if (isKey(pos, eol, "State:", 6)) {
+                const char* val = ProcReader::skipSpace(pos + 6, eol);
+                if (val < eol) {
+                    state = *val;
+                }
+            }
+            break;
+        case 'P':
+            if (isKey(pos, eol, "PPid:", 5)) {
+                ppid = scanStatusUnsigned(pos + 5, eol);
+            }
+            break;
+        case 'U':
+            if (identity
+             && isKey(pos, eol, "Uid:", 4)) {  // Real, Effective, Saved and FileSystem UID
+                m_uid = static_cast<uint32_t>(scanStatusUnsigned(pos + 4, eol));
+            }
+            break;
+        case 'G':
+            if (identity
+             && isKey(pos, eol, "Gid:", 4)) {
+                m_gid = static_cast<uint32_t>(scanStatusUnsigned(pos + 4, eol));
+            }
+            break;
+        case 'V':
+            if (isKey(pos, eol, "VmPeak:", 7)) {
+                vmPeakK = scanStatusUnsigned(pos + 7, eol);
+            }
+            else if (isKey(pos, eol, "VmSize:", 7)) {
+                vmSizeK = scanStatusUnsigned(pos + 7, eol);
+            }
+            else if (isKey(pos, eol, "VmData:", 7)) {
+                vmDataK = scanStatusUnsigned(pos + 7, eol);
+            }
+            else if (isKey(pos, eol, "VmStk:", 6)) {
+                vmStackK = scanStatusUnsigned(pos + 6, eol);
+            }
+            else if (isKey(pos, eol, "VmExe:", 6)) {
+                vmExecK = scanStatusUnsigned(pos + 6, eol);
+            }
+            else if (isKey(pos, eol, "VmRSS:", 6)) {
+                vmRssK = scanStatusUnsigned(pos + 6, eol);
+            }
+            break;
+        case 'R':
+            if (isKey(pos, eol, "RssAnon:", 8)) {
+                rssAnonK = scanStatusUnsigned(pos + 8, eol);
+            }
+            else if (isKey(pos, eol, "RssFile:", 8)) {
+                rssFileK = scanStatusUnsigned(pos + 8, eol);
+            }
+            break;
+        case 'v':
+            if (isKey(pos, eol, "voluntary_ctxt_switches:", 24)) {
+                ProcReader::scanUnsigned(pos + 24, eol, voluntaryCtxt);
+            }
+            break;
+        case 'n':
+            if (isKey(pos, eol, "nonvoluntary_ctxt_switches:", 27)) {
+                ProcReader::scanUnsigned(pos + 27, eol, nonvoluntaryCtxt);
+            }
+            break;
+        }
+        pos = eol + 1;
+    }
+    if (identity) {
+        if (!nameFound) {
+            m_name = NamePool::empty();
+        }
+        m_identityStale = false;
+        m_identityReads = 0u;
+    }
+    // the first read has no previous value (a running process has switched at least once)
+    uint64_t ctxt = voluntaryCtxt + nonvoluntaryCtxt;
+    uint64_t lastCtxt = m_voluntaryCtxt + m_nonvoluntaryCtxt;
+    m_ctxtDelta = lastCtxt > 0 && ctxt >= lastCtxt ? ctxt - lastCtxt : 0;
+    m_voluntaryCtxt = voluntaryCtxt;
+    m_nonvoluntaryCtxt = nonvoluntaryCtxt;
+}
+
+// the io file is only readable by the owner (or with CAP_SYS_PTRACE),
+//   remember if we were denied so it is not tried on every update
+void
+Process::read_io(ProcReader& reader)
+{
+    if (!reader.read(m_ioPath)) {
+        auto error = reader.getError();
+        if (error == EACCES
+         || error == EPERM) {
+            m_ioDenied = true;
+        }
+        m_ioDelta = 0;
+        return;     // a process that has gone is handled by stat/status
+    }
+    uint64_t readBytes{};
+    uint64_t writeBytes{};
+    const char* end = reader.end();
+    for (const char* pos = reader.begin(); pos < end; ) {
+        const char* eol = ProcReader::lineEnd(pos, end);
+        if (isKey(pos, eol, "read_bytes:", 11)) {
+            ProcReader::scanUnsigned(pos + 11, eol, readBytes);
+        }
+        else if (isKey(pos, eol, "write_bytes:", 12)) {
+            ProcReader::scanUnsigned(pos + 12, eol, writeBytes);
+        }
+        pos = eol + 1;
+    }
+    uint64_t bytes = readBytes + writeBytes;
+    uint64_t lastBytes = m_ioReadBytes + m_ioWriteBytes;
+    m_ioDelta = lastBytes > 0 && bytes >= lastBytes ? bytes - lastBytes : 0;
+    m_ioReadBytes = readBytes;
+    m_ioWriteBytes = writeBytes;
+}
 
 Glib::ustring
 Process::getDisplayName()
 {
-    Glib::ustring wname(name);
+    Glib::ustring wname(*m_name);
     return wname;
 }
 
@@ -278,16 +662,34 @@ Process::killProcess()
     kill(pid, SIGTERM);
 }
 
-std::shared_ptr<Buffer<double>>
-Process::getCpuData()
+void
+Process::addCpuData(Buffer<double>& buffer) const
+{
+    if (m_history) {
+        m_history->addTo(ProcessHistory::CPU, m_historyIndex, buffer);
+    }
+}
+
+void
+Process::addMemData(Buffer<double>& buffer) const
 {
-	return data_cpu;
+    if (m_history) {
+        m_history->addTo(ProcessHistory::MEM, m_historyIndex, buffer);
+    }
+}
+
+void
+Process::addIoData(Buffer<double>& buffer, double scale) const
+{
+    if (m_history) {
+        m_history->addTo(ProcessHistory::IO, m_historyIndex, buffer, scale);
+    }
 }
 
-std::shared_ptr<Buffer<double>>
-Process::getMemData()
+double
+Process::getIoUsageBuf() const
 {
-	return data_mem;
+    return m_history ? m_history->sum(ProcessHistory::IO, m_historyIndex) : 0.0;
 }
 
 void
@@ -305,7 +707,7 @@ Process::isTouched()
 const char*
 Process::getName()
 {
-	return name.c_str();
+	return m_name->c_str();
 }
 
 psc::gl::TreeNodeState
@@ -26,22 +26,27 @@
 
 #include "Geom2.hpp"
 #include "Monitor.hpp"
+#include "ProcReader.hpp"
+#include "ProcessHistory.hpp"
+#include "NamePool.hpp"
 
 class Process
 : public psc::gl::TreeNode2 {
 public:
-    Process(std::string path, long pid, guint _size);
-    virtual ~Process() = default;
+    // without history only the actual values are available
+    Process(std::string path, long pid, const pProcessHistory& history = pProcessHistory{});
+    virtual ~Process();
 
-    void roll();
     void setPid(long pid);
     long getPid() const;
-    void update();  // update basic data
+    void update(ProcReader& reader);  // update basic data
     void update(std::shared_ptr<Monitor> cpu, std::shared_ptr<Monitor> mem);    // update history
     Glib::ustring getDisplayName() override;
     bool isPrimary() override;
-    std::shared_ptr<Buffer<double>> getCpuData();
-    std::shared_ptr<Buffer<double>> getMemData();
+    // stack the history on buffer
+    void addCpuData(Buffer<double>& buffer) const;
+    void addMemData(Buffer<double>& buffer) const;
+    void addIoData(Buffer<double>& buffer, double scale) const;
     void setTouched(bool _touched);
     bool isTouched();
     const char* getName() override;
@@ -86,36 +91,153 @@ public:
     inline char getState() const {
         return state;
     }
+    // clock ticks after boot
+    inline unsigned long long getStartTime() const {
+        return starttime;
+    }
+    const std::string& getInternedName() const
+    {
+        return *m_name;
+    }
+    const NamePool::Name& getSharedName() const
+    {
+        return m_name;
+    }
+    inline uint64_t getIoReadBytes() const {
+        return m_ioReadBytes;
+    }
+    inline uint64_t getIoWriteBytes() const {
+        return m_ioWriteBytes;
+    }
+    // bytes read+written per update since the previous read (spread over the updates skipped when idle)
+    inline uint64_t getIoDelta() const {
+        return m_ioDelta;
+    }
+    inline uint64_t getVoluntaryCtxt() const {
+        return m_voluntaryCtxt;
+    }
+    inline uint64_t getNonvoluntaryCtxt() const {
+        return m_nonvoluntaryCtxt;
+    }
+    // context switches per update since the previous read
+    inline uint64_t getCtxtDelta() const {
+        return m_ctxtDelta;
+    }
+    // from the smaps_rollup (see MemDetailCollector), 0 if not read
+    void setMemDetail(long pssK, long ussK, long swapK)
+    {
+        m_pssK = pssK;
+        m_ussK = ussK;
+        m_swapK = swapK;
+    }
+    inline long getPssK() const {
+        return m_pssK;
+    }
+    inline long getUssK() const {
+        return m_ussK;
+    }
+    inline long getSwapK() const {
+        return m_swapK;
+    }
     void setStage(psc::gl::TreeNodeState _stage);
     bool isActive();
     long getMemUsage();
     long getMemGraph();
     long getPpid() const;
+    // true if the ppid changed since the tree was linked (or it was never linked)
+    bool isParentChanged() const
+    {
+        return ppid != m_linkedPpid;
+    }
+    void setLinked()
+    {
+        m_linkedPpid = ppid;
+    }
     unsigned long getCpuUsage();
     unsigned long getCpuUsageBuf();
     unsigned long getCpuUsageSum();
+    double getIoUsageBuf() const;
     void killProcess();
     static constexpr auto ROOT_UID = 0u;
     static constexpr auto ROOT_GID = 0u;
+    // these are the stream based reference implementations (see process_test)
     void update_status();
     void update_stat();
+    // parse from the readers buffer
+    void read_status(ProcReader& reader);
+    void read_stat(ProcReader& reader);
+    void read_io(ProcReader& reader);
+    // read the io file on update, as it is owner only this is remembered if denied
+    void setCollectIo(bool collectIo)
+    {
+        m_collectIo = collectIo;
+    }
+    bool isIoDenied() const
+    {
+        return m_ioDenied;
+    }
+    // a process without change of cpu time, rss and parent for IDLE_TICKS
+    //   reads the status (and io) only every idleCadence update, the stat is read on each
+    //   update, as soon as this shows a change everything is read again, 0, 1 disable
+    void setIdleCadence(uint32_t idleCadence)
+    {
+        m_idleCadence = idleCadence;
+    }
+    bool isIdle() const
+    {
+        return m_idleCadence > 1u && m_idleTicks >= IDLE_TICKS;
+    }
+    static constexpr auto IDLE_TICKS{4u};
+    // set on the scan if a filter is used (see ProcessesBase::setFilter)
+    void setFilterMatch(bool filterMatch)
+    {
+        m_filterMatch = filterMatch;
+    }
+    bool isFilterMatch() const
+    {
+        return m_filterMatch;
+    }
+    // matches or has a matching descendant
+    void setShown(bool shown)
+    {
+        m_shown = shown;
+    }
+    bool isShown() const
+    {
+        return m_shown;
+    }
+    // keep the stat/status files open for the lifetime of this process
+    void setKeepOpen(bool keepOpen);
+    bool isKeepOpen() const
+    {
+        return m_keepOpen;
+    }
 
 private:
+    bool readProc(ProcReader& reader, const std::string& name, int& fd);
+    void readFailed(ProcReader& reader);
+
     // internal
     bool touched;
 
     psc::gl::TreeNodeState stage;  // when getting an error on reading set this to false so we wont ask again
     std::string path;
+    std::string m_statPath;
+    std::string m_statusPath;
+    std::string m_ioPath;
+    bool m_keepOpen;
+    int m_statFd;
+    int m_statusFd;
+    long m_linkedPpid;
     Position pos;
     unsigned long lastCpuTime;
-    guint m_size;
-    std::shared_ptr<Buffer<double>> data_cpu;
-    std::shared_ptr<Buffer<double>> data_mem;
+    pProcessHistory m_history;
+    uint32_t m_historyIndex;
     Gdk::RGBA m_color;
     unsigned long cpuTime;
     // status fields
     long pid;
-    std::string name;
+    NamePool::Name m_name;      // interned
     char state;
     long ppid;
     long vmPeakK;
@@ -218,6 +340,29 @@ private:
                         // process; see the description of RLIMIT_RSS in
                         // getrlimit(2).
     double m_load;      // load ratio 0..1
+    bool m_collectIo;
+    bool m_ioDenied;    // do not retry for the lifetime of the process
+    uint64_t m_ioReadBytes;     // io fields (cumulated)
+    uint64_t m_ioWriteBytes;
+    uint64_t m_ioDelta;
+    uint64_t m_voluntaryCtxt;   // status fields (cumulated)
+    uint64_t m_nonvoluntaryCtxt;
+    uint64_t m_ctxtDelta;
+    long m_pssK;        // smaps_rollup fields
+    long m_ussK;
+    long m_swapK;
+    uint32_t m_idleCadence;
+    uint32_t m_idleTicks;   // updates without change
+    uint32_t m_skippedTicks;    // updates without status (and io) read since the last
+    uint32_t m_deltaTicks;      // updates covered by the deltas, these are per update
+    bool m_filterMatch;
+    bool m_shown;
+    // the name and uid/gid are parsed from the status only if the process exec'd
+    //   (the comm or starttime in stat changed), or with IDENTITY_REFRESH for setuid
+    NamePool::Name m_comm;      // interned stat comm
+    bool m_identityStale;
+    uint32_t m_identityReads;
+    static constexpr auto IDENTITY_REFRESH{16u};
     uint32_t m_uid;
     uint32_t m_gid;
 };
@@ -0,0 +1,426 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <strings.h>
+#include <cstring>
+#include <cstdlib>
+#include <algorithm>
+
+#include "ProcessFilter.hpp"
+#include "Process.hpp"
+#include "ProcessSnapshot.hpp"
+#include "NamePool.hpp"
+
+static const char*
+skipBlank(const char* pos, const char* end)
+{
+    while (pos < end && (*pos == ' ' || *pos == '\t')) {
+        ++pos;
+    }
+    return pos;
+}
+
+static bool
+isToken(const char* pos, const char* end, const char* token)
+{
+    size_t len = std::strlen(token);
+    return static_cast<size_t>(end - pos) >= len
+        && std::memcmp(pos, token, len) == 0;
+}
+
+bool
+ProcessFilter::parse(const std::string& expr)
+{
+    m_program.clear();
+    m_error.clear();
+    const char* pos = expr.data();
+    const char* end = pos + expr.size();
+    pos = skipBlank(pos, end);
+    if (pos == end) {
+        return true;    // match all
+    }
+    if (!parseOr(pos, end)) {
+        m_program.clear();
+        return false;
+    }
+    if (pos != end) {
+        m_program.clear();
+        return fail(pos, end, "Unexpected");
+    }
+    uint32_t depth = 0u;    // the terms push, the combining pop two and push one
+    uint32_t maxDepth = 0u;
+    for (auto& term : m_program) {
+        if (term.op == Op::And || term.op == Op::Or) {
+            --depth;
+        }
+        else if (term.op != Op::Not) {
+            ++depth;
+            maxDepth = std::max(maxDepth, depth);
+        }
+    }
+    if (maxDepth > MAX_DEPTH) {
+        m_program.clear();
+        m_error = "Expression too deep";
+        return false;
+    }
+    return true;
+}
+
+bool
+ProcessFilter::fail(const char* pos, const char* end, const char* what)
+{
+    m_error = what;
+    if (pos < end) {
+        m_error += " at '";
+        m_error.append(pos, std::min(end - pos, static_cast<std::ptrdiff_t>(16)));
+        m_error += "'";
+    }
+    else {
+        m_error += " at end";
+    }
+    return false;
+}
+
+bool
+ProcessFilter::parseOr(const char*& pos, const char* end)
+{
+    if (!parseAnd(pos, end)) {
+        return false;
+    }
+    while (isToken(pos, end, "||")) {
+        pos = skipBlank(pos + 2, end);
+        if (!parseAnd(pos, end)) {
+            return false;
+        }
+        m_program.push_back(Term{Op::Or, Field::Name, false, 0.0, std::string()});
+    }
+    return true;
+}
+
+bool
+ProcessFilter::parseAnd(const char*& pos, const char* end)
+{
+    if (!parseUnary(pos, end)) {
+        return false;
+    }
+    while (isToken(pos, end, "&&")) {
+        pos = skipBlank(pos + 2, end);
+        if (!parseUnary(pos, end)) {
+            return false;
+        }
+        m_program.push_back(Term{Op::And, Field::Name, false, 0.0, std::string()});
+    }
+    return true;
+}
+
+bool
+ProcessFilter::parseUnary(const char*& pos, const char* end)
+{
+    if (pos < end && *pos == '!') {
+        pos = skipBlank(pos + 1, end);
+        if (!parseUnary(pos, end)) {
+            return false;
+        }
+        m_program.push_back(Term{Op::Not, Field::Name, false, 0.0, std::string()});
+        return true;
+    }
+    if (pos < end && *pos == '(') {
+        pos = skipBlank(pos + 1, end);
+        if (!parseOr(pos, end)) {
+            return false;
+        }
+        if (pos == end || *pos != ')') {
+            return fail(pos, end, "Expected )");
+        }
+        pos = skipBlank(pos + 1, end);
+        return true;
+    }
+    return parseTerm(pos, end);
+}
+
+bool
+ProcessFilter::isTextField(Field field)
+{
+    return field == Field::Name
+        || field == Field::User
+        || field == Field::Group
+        || field == Field::State;
+}
+
+bool
+ProcessFilter::parseTerm(const char*& pos, const char* end)
+{
+    static const struct {
+        const char* name;
+        Field field;
+    } fields[] = {
+        {"name", Field::Name},
+        {"user", Field::User},
+        {"group", Field::Group},
+        {"state", Field::State},
+        {"pid", Field::Pid},
+        {"ppid", Field::Ppid},
+        {"uid", Field::Uid},
+        {"gid", Field::Gid},
+        {"threads", Field::Threads},
+        {"load", Field::Load},
+        {"rss", Field::Rss},
+        {"vsize", Field::Vsize},
+        {"io", Field::Io}
+    };
+    static const struct {
+        const char* token;
+        Op op;
+    } ops[] = {     // the longer first
+        {"==", Op::Equal},
+        {"!=", Op::NotEqual},
+        {"<=", Op::LessEqual},
+        {">=", Op::GreaterEqual},
+        {"<", Op::Less},
+        {">", Op::Greater},
+        {"~", Op::Contains}
+    };
+    const char* start = pos;
+    while (pos < end && ((*pos >= 'a' && *pos <= 'z') || (*pos >= 'A' && *pos <= 'Z'))) {
+        ++pos;
+    }
+    if (pos == start) {
+        return fail(pos, end, "Expected field");
+    }
+    Term term{Op::Equal, Field::Name, false, 0.0, std::string()};
+    bool found = false;
+    for (auto& field : fields) {
+        if (static_cast<size_t>(pos - start) == std::strlen(field.name)
+         && strncasecmp(start, field.name, pos - start) == 0) {
+            term.field = field.field;
+            found = true;
+            break;
+        }
+    }
+    if (!found) {
+        return fail(start, end, "Unknown field");
+    }
+    pos = skipBlank(pos, end);
+    found = false;
+    for (auto& op : ops) {
+        if (isToken(pos, end, op.token)) {
+            term.op = op.op;
+            pos = skipBlank(pos + std::strlen(op.token), end);
+            found = true;
+            break;
+        }
+    }
+    if (!found) {
+        return fail(pos, end, "Expected operator");
+    }
+    const char* value = pos;
+    if (pos < end && *pos == '"') {
+        value = ++pos;
+        while (pos < end && *pos != '"') {
+            ++pos;
+        }
+        if (pos == end) {
+            return fail(value - 1, end, "Unterminated \"");
+        }
+        term.text.assign(value, pos);
+        ++pos;
+    }
+    else {
+        while (pos < end && *pos != ' ' && *pos != '\t'
+            && *pos != '&' && *pos != '|' && *pos != ')') {
+            ++pos;
+        }
+        if (pos == value) {
+            return fail(pos, end, "Expected value");
+        }
+        term.text.assign(value, pos);
+    }
+    pos = skipBlank(pos, end);
+    // a number with an optional size suffix
+    char* numEnd = nullptr;
+    double number = std::strtod(term.text.c_str(), &numEnd);
+    if (numEnd != term.text.c_str()) {
+        switch (*numEnd) {
+        case 'k':
+        case 'K':
+            number *= 1024.0;
+            ++numEnd;
+            break;
+        case 'M':
+            number *= 1024.0 * 1024.0;
+            ++numEnd;
+            break;
+        case 'G':
+            number *= 1024.0 * 1024.0 * 1024.0;
+            ++numEnd;
+            break;
+        }
+    }
+    bool isNumber = numEnd != term.text.c_str() && *numEnd == '\0';
+    if (isTextField(term.field)) {
+        term.numeric = isNumber
+                    && (term.field == Field::User || term.field == Field::Group)
+                    && term.op != Op::Contains;
+    }
+    else {
+        if (!isNumber) {
+            return fail(value, end, "Expected number");
+        }
+        if (term.op == Op::Contains) {
+            return fail(value, end, "Contains requires a text field");
+        }
+        term.numeric = true;
+    }
+    term.number = number;
+    m_program.push_back(std::move(term));
+    return true;
+}
+
+// op in the order of ProcessFilter::Op
+template<typename T>
+static bool
+compareValues(const T& value, const T& with, int op)
+{
+    switch (op) {
+    case 0:
+        return value == with;
+    case 1:
+        return value != with;
+    case 2:
+        return value < with;
+    case 3:
+        return value <= with;
+    case 4:
+        return value > with;
+    case 5:
+        return value >= with;
+    }
+    return false;
+}
+
+template<typename P>
+bool
+ProcessFilter::compare(const Term& term, const P& process) const
+{
+    if (term.numeric) {
+        double value{};
+        switch (term.field) {
+        case Field::Pid:
+            value = static_cast<double>(process.getPid());
+            break;
+        case Field::Ppid:
+            value = static_cast<double>(process.getPpid());
+            break;
+        case Field::Uid:
+        case Field::User:
+            value = static_cast<double>(process.getUid());
+            break;
+        case Field::Gid:
+        case Field::Group:
+            value = static_cast<double>(process.getGid());
+            break;
+        case Field::Threads:
+            value = static_cast<double>(process.getThreads());
+            break;
+        case Field::Load:
+            value = process.getRawLoad() * 100.0;
+            break;
+        case Field::Rss:
+            value = static_cast<double>(process.getVmRssK()) * 1024.0;
+            break;
+        case Field::Vsize:
+            value = static_cast<double>(process.getVmSizeK()) * 1024.0;
+            break;
+        case Field::Io:
+            value = static_cast<double>(process.getIoReadBytes() + process.getIoWriteBytes());
+            break;
+        default:
+            return false;
+        }
+        return compareValues(value, term.number, static_cast<int>(term.op));
+    }
+    std::string state;
+    const std::string* value;
+    switch (term.field) {
+    case Field::Name:
+        value = &process.getInternedName();
+        break;
+    case Field::User:
+        value = &NamePool::userName(process.getUid());
+        break;
+    case Field::Group:
+        value = &NamePool::groupName(process.getGid());
+        break;
+    case Field::State:
+        state.assign(1, process.getState());
+        value = &state;
+        break;
+    default:
+        return false;
+    }
+    if (term.op == Op::Contains) {
+        return value->find(term.text) != std::string::npos;
+    }
+    return compareValues(*value, term.text, static_cast<int>(term.op));
+}
+
+// the results are kept as bits, the last result is the lowest
+template<typename P>
+bool
+ProcessFilter::evaluate(const P& process) const
+{
+    if (m_program.empty()) {
+        return true;
+    }
+    uint64_t stack{};
+    for (auto& term : m_program) {
+        switch (term.op) {
+        case Op::And: {
+            uint64_t last = stack & 1u;
+            stack >>= 1u;
+            stack = (stack & ~1ull) | (stack & last);
+            break;
+        }
+        case Op::Or: {
+            uint64_t last = stack & 1u;
+            stack >>= 1u;
+            stack |= last;
+            break;
+        }
+        case Op::Not:
+            stack ^= 1u;
+            break;
+        default:
+            stack = (stack << 1u) | (compare(term, process) ? 1u : 0u);
+            break;
+        }
+    }
+    return (stack & 1u) != 0u;
+}
+
+bool
+ProcessFilter::matches(const Process& process) const
+{
+    return evaluate(process);
+}
+
+bool
+ProcessFilter::matches(const ProcessInfo& info) const
+{
+    return evaluate(info);
+}
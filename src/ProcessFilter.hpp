@@ -0,0 +1,102 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdint>
+
+class Process;
+class ProcessInfo;
+
+// a filter expression compiled once and evaluated for each process on the scan e.g.
+//   user==www && rss>500M && state==D
+//   terms are <field><op><value> with the ops == != < <= > >= and ~ (contains),
+//   combined with && (binding first), || and ! with ( ) for grouping.
+//   The fields are name, user, group, state (compared as text, user and group
+//   as uid, gid if the value is a number) and pid, ppid, uid, gid, threads,
+//   load (percent), rss, vsize, io (read+written bytes), the sizes in bytes
+//   with the suffixes K, M, G (base 1024).
+class ProcessFilter
+{
+public:
+    ProcessFilter() = default;
+    explicit ProcessFilter(const ProcessFilter& orig) = delete;
+    virtual ~ProcessFilter() = default;
+
+    // on false see getError, an empty expression matches all
+    bool parse(const std::string& expr);
+    const std::string& getError() const
+    {
+        return m_error;
+    }
+    // does not modify, so this may be used by all scan threads
+    bool matches(const Process& process) const;
+    bool matches(const ProcessInfo& info) const;
+    static constexpr auto MAX_DEPTH{64u};  // the evaluation stack is one bit per term
+private:
+    enum class Field {
+        Name,
+        User,
+        Group,
+        State,
+        Pid,
+        Ppid,
+        Uid,
+        Gid,
+        Threads,
+        Load,
+        Rss,
+        Vsize,
+        Io
+    };
+    enum class Op {
+        Equal,
+        NotEqual,
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual,
+        Contains,
+        And,    // these combine the results on the stack
+        Or,
+        Not
+    };
+    struct Term {
+        Op op;
+        Field field;
+        bool numeric;   // compare number
+        double number;
+        std::string text;
+    };
+
+    bool parseOr(const char*& pos, const char* end);
+    bool parseAnd(const char*& pos, const char* end);
+    bool parseUnary(const char*& pos, const char* end);
+    bool parseTerm(const char*& pos, const char* end);
+    bool fail(const char* pos, const char* end, const char* what);
+    template<typename P>
+    bool evaluate(const P& process) const;
+    template<typename P>
+    bool compare(const Term& term, const P& process) const;
+    static bool isTextField(Field field);
+
+    std::vector<Term> m_program;    // postfix order
+    std::string m_error;
+};
@@ -0,0 +1,140 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include "ProcessHistory.hpp"
+
+ProcessHistory::ProcessHistory(uint32_t slots)
+: m_slots{std::max(slots, 1u)}
+, m_capacity{0u}
+, m_head{0u}
+, m_enabled{true, true, false}
+, m_used{0u}
+{
+}
+
+uint32_t
+ProcessHistory::allocate()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    uint32_t index;
+    if (!m_free.empty()) {
+        index = m_free.back();
+        m_free.pop_back();
+    }
+    else {
+        if (m_used >= m_capacity) {
+            grow();
+        }
+        index = m_used++;
+    }
+    for (uint32_t m = 0; m < METRICS; ++m) {   // a reused index may have values from the previous process
+        if (!m_enabled[m]) {
+            continue;
+        }
+        for (uint32_t slot = 0; slot < m_slots; ++slot) {
+            m_values[m][static_cast<size_t>(slot) * m_capacity + index] = 0.0f;
+        }
+        m_sums[m][index] = 0.0;
+    }
+    return index;
+}
+
+void
+ProcessHistory::release(uint32_t index)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_free.push_back(index);
+}
+
+void
+ProcessHistory::setEnabled(Metric metric, bool enabled)
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (enabled == m_enabled[metric]) {
+        return;
+    }
+    m_enabled[metric] = enabled;
+    if (enabled) {
+        m_values[metric].assign(static_cast<size_t>(m_slots) * m_capacity, 0.0f);
+        m_sums[metric].assign(m_capacity, 0.0);
+    }
+    else {
+        std::vector<float>().swap(m_values[metric]);
+        std::vector<double>().swap(m_sums[metric]);
+    }
+}
+
+void
+ProcessHistory::set(Metric metric, uint32_t index, float value)
+{
+    if (!m_enabled[metric]) {
+        return;
+    }
+    auto& val = m_values[metric][static_cast<size_t>(m_head) * m_capacity + index];
+    m_sums[metric][index] += static_cast<double>(value) - static_cast<double>(val);
+    val = value;
+}
+
+void
+ProcessHistory::setRecent(Metric metric, uint32_t index, uint32_t count, float value)
+{
+    if (!m_enabled[metric]) {
+        return;
+    }
+    uint32_t slot = m_head;
+    for (uint32_t i = 0; i < std::min(count, m_slots); ++i) {
+        auto& val = m_values[metric][static_cast<size_t>(slot) * m_capacity + index];
+        m_sums[metric][index] += static_cast<double>(value) - static_cast<double>(val);
+        val = value;
+        slot = slot > 0u ? slot - 1u : m_slots - 1u;
+    }
+}
+
+void
+ProcessHistory::addTo(Metric metric, uint32_t index, Buffer<double>& buffer, double scale) const
+{
+    if (!m_enabled[metric]) {
+        return;
+    }
+    for (uint32_t i = 0; i < m_slots; ++i) {
+        buffer.set(i, buffer.get(i) + static_cast<double>(get(metric, index, i)) * scale);
+    }
+    buffer.refreshSum();
+}
+
+// the rows get wider, so copy them to their new place
+void
+ProcessHistory::grow()
+{
+    uint32_t capacity = std::max(m_capacity * 2u, INITIAL_CAPACITY);
+    for (uint32_t m = 0; m < METRICS; ++m) {
+        if (!m_enabled[m]) {
+            continue;
+        }
+        std::vector<float> values(static_cast<size_t>(m_slots) * capacity);
+        for (uint32_t slot = 0; slot < m_slots && m_capacity > 0u; ++slot) {
+            std::copy_n(m_values[m].begin() + static_cast<ptrdiff_t>(slot) * m_capacity, m_capacity
+                      , values.begin() + static_cast<ptrdiff_t>(slot) * capacity);
+        }
+        m_values[m] = std::move(values);
+        m_sums[m].resize(capacity);
+    }
+    m_capacity = capacity;
+}
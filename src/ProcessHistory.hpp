@@ -0,0 +1,109 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <vector>
+#include <memory>
+#include <cstdint>
+#include <mutex>
+
+#include "Buffer.hpp"
+
+// the history of the process values in one place,
+//   each metric is a ring of rows [slot][process index]
+//   with a shared head, so rolling all processes is a increment.
+//   A process allocates its index (column) on creation
+//   and releases it on destruction.
+//   Processes are created by the scan threads, so allocate/release are locked,
+//   all other access is expected from the updating thread outside the scan.
+//   The values are stored as float as they are fractions of the total
+//   (or bytes per update for io).
+//   Only the enabled metrics are allocated, CPU and MEM by default.
+class ProcessHistory
+{
+public:
+    enum Metric {
+        CPU = 0,
+        MEM = 1,
+        IO = 2,     // bytes per update
+        METRICS = 3
+    };
+
+    ProcessHistory(uint32_t slots);
+    explicit ProcessHistory(const ProcessHistory& orig) = delete;
+    virtual ~ProcessHistory() = default;
+
+    uint32_t allocate();
+    void release(uint32_t index);
+    // a disabled metric is released, set is ignored and the values read as 0
+    //   (call from the updating thread as set)
+    void setEnabled(Metric metric, bool enabled);
+    bool isEnabled(Metric metric) const
+    {
+        return m_enabled[metric];
+    }
+    // advance to the next slot, as each active process sets its value on update the slot is not cleared
+    void roll()
+    {
+        m_head = m_head + 1u < m_slots ? m_head + 1u : 0u;
+    }
+    // set the newest value
+    void set(Metric metric, uint32_t index, float value);
+    // set the newest count values (limited to the slots) e.g. for a value measured over some updates
+    void setRecent(Metric metric, uint32_t index, uint32_t count, float value);
+    // i = 0 oldest ... getSlots() - 1 newest
+    float get(Metric metric, uint32_t index, uint32_t i) const
+    {
+        if (!m_enabled[metric]) {
+            return 0.0f;
+        }
+        uint32_t slot = m_head + 1u + i;
+        if (slot >= m_slots) {
+            slot -= m_slots;
+        }
+        return m_values[metric][static_cast<size_t>(slot) * m_capacity + index];
+    }
+    // sum of all slots, kept on set
+    double sum(Metric metric, uint32_t index) const
+    {
+        return m_enabled[metric] ? m_sums[metric][index] : 0.0;
+    }
+    // add the (scaled) values of index to buffer e.g. to stack graphs
+    void addTo(Metric metric, uint32_t index, Buffer<double>& buffer, double scale = 1.0) const;
+    uint32_t getSlots() const
+    {
+        return m_slots;
+    }
+    static constexpr uint32_t NO_INDEX{UINT32_MAX};
+private:
+    void grow();
+
+    uint32_t m_slots;
+    uint32_t m_capacity;    // number of process columns in each row
+    uint32_t m_head;
+    std::vector<float> m_values[METRICS];
+    std::vector<double> m_sums[METRICS];
+    bool m_enabled[METRICS];
+    std::vector<uint32_t> m_free;
+    uint32_t m_used;
+    std::mutex m_mutex;     // for allocate/release
+    static constexpr uint32_t INITIAL_CAPACITY{256u};
+};
+
+using pProcessHistory = std::shared_ptr<ProcessHistory>;
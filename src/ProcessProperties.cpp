@@ -17,25 +17,24 @@
  */
 
 #include <Log.hpp>
-#include <unistd.h>     // getpwduid
-#include <sys/types.h>  // getpwduid
-#include <pwd.h>        // getpwduid
-#include <grp.h>        // getgrgid
-#include <typeinfo>
+#include <signal.h>
 
 #include "ProcessProperties.hpp"
 #include "NetworkProperties.hpp"
 #include "Process.hpp"
+#include "NamePool.hpp"
 
 
-ProcessProperties::ProcessProperties(BaseObjectType* cobject, const Glib::RefPtr<Gtk::Builder>& builder, const long processId, Glib::KeyFile* keyFile, int32_t update_interval)
+ProcessProperties::ProcessProperties(BaseObjectType* cobject, const Glib::RefPtr<Gtk::Builder>& builder, const long processId, ProcessesBase* processes, Glib::KeyFile* keyFile, int32_t update_interval)
 : Gtk::Dialog{cobject}
-, m_processes{std::make_shared<ProcessesBase>()}
+, m_processes{processes}
 , m_processId{processId}
 , m_keyFile{keyFile}
 , m_update_interval{update_interval}
+, m_generation{0u}
 , m_propertyColumns{std::make_shared<ProcessColumns>()}
 {
+    m_processes->subscribeSnapshot();
     auto object = builder->get_object("properties");
     m_procTree = Glib::RefPtr<Gtk::TreeView>::cast_dynamic(object);
     if (m_procTree) {
@@ -71,6 +70,34 @@ ProcessProperties::ProcessProperties(BaseObjectType* cobject, const Glib::RefPtr
     else {
         psc::log::Log::logAdd(psc::log::Level::Warn, "Not found Gtk::Button named net");
     }
+    object = builder->get_object("threads");
+    m_threadsButton = Glib::RefPtr<Gtk::ToggleButton>::cast_dynamic(object);
+    if (m_threadsButton) {
+        m_threadsButton->signal_toggled().connect(
+                sigc::mem_fun(*this, &ProcessProperties::sampleThreads));
+    }
+    else {
+        psc::log::Log::logAdd(psc::log::Level::Warn, "Not found Gtk::ToggleButton named threads");
+    }
+    object = builder->get_object("filter");
+    m_filterEntry = Glib::RefPtr<Gtk::SearchEntry>::cast_dynamic(object);
+    if (m_filterEntry) {
+        m_filterEntry->signal_activate().connect(
+                sigc::mem_fun(*this, &ProcessProperties::applyFilter));
+        m_filterEntry->signal_search_changed().connect([this] {
+            if (m_filterEntry->get_text().empty()) {    // cleared with the icon
+                applyFilter();
+            }
+        });
+    }
+    else {
+        psc::log::Log::logAdd(psc::log::Level::Warn, "Not found Gtk::SearchEntry named filter");
+    }
+}
+
+ProcessProperties::~ProcessProperties()
+{
+    m_processes->unsubscribeSnapshot();
 }
 
 
@@ -85,22 +112,59 @@ ProcessProperties::on_response(int response_id)
     Gtk::Dialog::on_response(response_id);
 }
 
+// sample the threads of the selected process (or the shown if none is selected)
+void
+ProcessProperties::sampleThreads()
+{
+    if (m_threadsButton->get_active()) {
+        long pid = m_processId;
+        auto iter = m_procTree->get_selection()->get_selected();
+        if (iter) {
+            pid = iter->get_value(m_propertyColumns->m_pid);
+        }
+        m_threadSampler.add(pid);
+    }
+    else {
+        m_threadSampler.clear();
+    }
+    refresh();
+}
+
+// the filter is evaluated once for each snapshot, only the shown processes get rows
+void
+ProcessProperties::applyFilter()
+{
+    auto filter = std::make_shared<ProcessFilter>();
+    if (filter->parse(m_filterEntry->get_text())) {
+        m_filterEntry->set_tooltip_text("");
+        m_filterEntry->get_style_context()->remove_class("error");
+        if (m_filterEntry->get_text().empty()) {
+            filter.reset();
+        }
+        m_filter = filter;
+        m_snapshot.reset();     // apply to the actual
+        refresh();
+    }
+    else {
+        m_filterEntry->set_tooltip_text(filter->getError());
+        m_filterEntry->get_style_context()->add_class("error");
+    }
+}
+
 void
 ProcessProperties::stopProcess()
 {
     auto treeSel = m_procTree->get_selection();
     if (treeSel->count_selected_rows() > 0) {
         auto iter = treeSel->get_selected();
-        while (iter) {
+        if (iter) {
             auto row = *iter;
-            auto process = row.get_value(m_propertyColumns->m_process);
-            if (process) {
-                psc::log::Log::logAdd(psc::log::Level::Info, [&] {
-                    return psc::fmt::format("Kill {} {}!", process->getName(), process->getPid());
-                });
-                process->killProcess();
-                ++iter;
-            }
+            long pid = row.get_value(m_propertyColumns->m_pid);
+            Glib::ustring name = row.get_value(m_propertyColumns->m_name);
+            psc::log::Log::logAdd(psc::log::Level::Info, [&] {
+                return psc::fmt::format("Kill {} {}!", name.raw(), pid);
+            });
+            kill(static_cast<pid_t>(pid), SIGTERM);
         }
     }
     else {
@@ -118,124 +182,195 @@ ProcessProperties::stopProcess()
 }
 
 
+// set only the changed values, as each set is signaled to the view
+template<typename T>
+static void
+setChanged(const Gtk::TreeModel::Row& row, const Gtk::TreeModelColumn<T>& col, const T& value)
+{
+    if (row.get_value(col) != value) {
+        row.set_value(col, value);
+    }
+}
+
 void
-ProcessProperties::addProcess(const Gtk::TreeModel::iterator& i, pProcess& process)
+ProcessProperties::setValues(const Gtk::TreeModel::Row& row, const ProcessInfo& process)
 {
-	auto row = *i;
-	row.set_value(m_propertyColumns->m_name, process->getDisplayName());
-    row.set_value(m_propertyColumns->m_pid, process->getPid());
-    row.set_value(m_propertyColumns->m_load, process->getRawLoad());
-    row.set_value(m_propertyColumns->m_vmPeak, process->getVmPeakK());
-    row.set_value(m_propertyColumns->m_vmSize, process->getVmSizeK());
-    row.set_value(m_propertyColumns->m_vmData, process->getVmDataK());
-    row.set_value(m_propertyColumns->m_vmStack, process->getVmStackK());
-    row.set_value(m_propertyColumns->m_vmExec, process->getVmExecK());
-    row.set_value(m_propertyColumns->m_vmRss, process->getVmRssK());
-    row.set_value(m_propertyColumns->m_rssAnon, process->getRssAnonK());
-    row.set_value(m_propertyColumns->m_rssFile, process->getRssFileK());
-    row.set_value(m_propertyColumns->m_threads, process->getThreads());
-    row.set_value(m_propertyColumns->m_user, getUid2Name(process->getUid()));
-    row.set_value(m_propertyColumns->m_group, getGid2Name(process->getGid()));
-    row.set_value(m_propertyColumns->m_state, Glib::ustring::sprintf("%c", process->getState()));
-    row.set_value(m_propertyColumns->m_process, process);
-    for (auto& child : process->getChildren()) {
-        auto processChild = dynamic_pointer_cast<Process>(child) ;
-        if (processChild) {
-            auto n = m_properties->append(row.children());
-            addProcess(n, processChild);
+    setChanged(row, m_propertyColumns->m_name, Glib::ustring(process.getInternedName()));
+    setChanged(row, m_propertyColumns->m_pid, process.getPid());
+    setChanged(row, m_propertyColumns->m_load, process.getRawLoad());
+    setChanged(row, m_propertyColumns->m_vmPeak, process.getVmPeakK());
+    setChanged(row, m_propertyColumns->m_vmSize, process.getVmSizeK());
+    setChanged(row, m_propertyColumns->m_vmData, process.getVmDataK());
+    setChanged(row, m_propertyColumns->m_vmStack, process.getVmStackK());
+    setChanged(row, m_propertyColumns->m_vmExec, process.getVmExecK());
+    setChanged(row, m_propertyColumns->m_vmRss, process.getVmRssK());
+    setChanged(row, m_propertyColumns->m_rssAnon, process.getRssAnonK());
+    setChanged(row, m_propertyColumns->m_rssFile, process.getRssFileK());
+    setChanged(row, m_propertyColumns->m_threads, process.getThreads());
+    setChanged(row, m_propertyColumns->m_ioRead, static_cast<gulong>(process.getIoReadBytes()));
+    setChanged(row, m_propertyColumns->m_ioWrite, static_cast<gulong>(process.getIoWriteBytes()));
+    setChanged(row, m_propertyColumns->m_ctxtSwitches, static_cast<gulong>(process.getCtxtSwitches()));
+    setChanged(row, m_propertyColumns->m_user, getUid2Name(process.getUid()));
+    setChanged(row, m_propertyColumns->m_group, getGid2Name(process.getGid()));
+    setChanged(row, m_propertyColumns->m_state, Glib::ustring::sprintf("%c", process.getState()));
+}
+
+// keep the row of a process, it is only inserted again if the process is new or got a new parent,
+//   the rows are found by pid, the rows not visited by this update are removed by refresh
+void
+ProcessProperties::updateProcess(const Gtk::TreeModel::iterator& parent, const ProcessInfo& process)
+{
+    long pid = process.getPid();
+    Gtk::TreeModel::iterator iter;
+    uint32_t threads{};
+    auto processRow = m_rows.find(pid);
+    if (processRow && processRow->ref.is_valid()) {
+        auto known = m_properties->get_iter(processRow->ref.get_path());
+        auto knownParent = known->parent();
+        if (processRow->startTime == process.getStartTime()
+         && (parent ? knownParent == parent : !knownParent)) {
+            iter = known;
+            threads = processRow->threads;
+        }
+        else {      // the pid was reused, or the parent changed
+            m_properties->erase(known);     // the children are inserted again if still shown
+        }
+    }
+    const bool inserted = !iter;
+    if (inserted) {
+        iter = parent ? m_properties->append(parent->children()) : m_properties->append();
+    }
+    auto row = *iter;
+    setValues(row, process);
+    threads = updateThreads(row, pid, threads);
+    if (inserted) {
+        ProcessRow newRow{process.getStartTime(), Gtk::TreeRowReference(m_properties, m_properties->get_path(iter)), m_generation, threads};
+        if (processRow) {
+            *processRow = newRow;
         }
         else {
-            psc::log::Log::logAdd(psc::log::Level::Notice, [&] {
-                return psc::fmt::format("Traversing process {}", typeid(child).name());
-            });
+            m_rows.insert(pid, newRow);
+        }
+    }
+    else {
+        processRow->generation = m_generation;
+        processRow->threads = threads;
+    }
+    for (uint32_t child = process.getFirstChild(); child != ProcessSnapshot::NONE; ) {
+        auto& processChild = m_snapshot->get(child);
+        if (m_shown.empty() || m_shown[child]) {
+            updateProcess(iter, processChild);
         }
+        child = processChild.getNextSibling();
+    }
+    if (inserted
+     && !row.children().empty()
+     && (!parent || m_procTree->row_expanded(m_properties->get_path(parent)))) {
+        m_procTree->expand_row(m_properties->get_path(iter), true);    // show new like the others, keep the collapsed
     }
 }
 
-bool
-ProcessProperties::selectProcess(const Gtk::TreeModel::iterator& i, pProcess& selectedProcess)
+// the threads are shown as first children, the load is relative to one cpu,
+//   these are replaced on each update (only for the sampled processes)
+uint32_t
+ProcessProperties::updateThreads(const Gtk::TreeModel::Row& row, long pid, uint32_t threads)
 {
-    if (i) {
-        auto row = *i;
-        auto process = row.get_value(m_propertyColumns->m_process);
-        if (selectedProcess == process) {
-            m_procTree->get_selection()->select(row);
-            return true;
-        }
-        for (auto& child : row.children()) {
-            if (selectProcess(child, selectedProcess)) {
-                return true;
+    for (uint32_t i = 0; i < threads && !row.children().empty(); ++i) {
+        m_properties->erase(row.children().begin());
+    }
+    if (!m_threadSampler.isSampled(pid)) {
+        return 0u;
+    }
+    m_threadSampler.getThreads(pid, m_threads);
+    auto before = row.children().begin();   // the iterators of a tree store persist
+    for (auto thread : m_threads) {
+        auto task = thread->task;
+        auto threadIter = before != row.children().end()
+                        ? m_properties->insert(before)
+                        : m_properties->append(row.children());
+        auto threadRow = *threadIter;
+        threadRow.set_value(m_propertyColumns->m_name, task->getDisplayName());
+        threadRow.set_value(m_propertyColumns->m_pid, task->getPid());
+        threadRow.set_value(m_propertyColumns->m_load, thread->load);
+        threadRow.set_value(m_propertyColumns->m_user, getUid2Name(task->getUid()));
+        threadRow.set_value(m_propertyColumns->m_group, getGid2Name(task->getGid()));
+        threadRow.set_value(m_propertyColumns->m_state, Glib::ustring::sprintf("%c", task->getState()));
+    }
+    return static_cast<uint32_t>(m_threads.size());
+}
+
+// show the matching processes with their ancestors
+void
+ProcessProperties::markShown()
+{
+    m_shown.clear();
+    if (!m_filter) {
+        return;     // all
+    }
+    m_shown.resize(m_snapshot->size(), false);
+    for (auto& info : m_snapshot->getProcesses()) {
+        if (m_filter->matches(info)) {
+            for (uint32_t i = m_snapshot->indexOf(info); i != ProcessSnapshot::NONE && !m_shown[i]; ) {
+                m_shown[i] = true;
+                i = m_snapshot->get(i).getParent();
             }
         }
     }
-    return false;
 }
 
+// the processes are taken from the snapshot of the main view (no scan of our own),
+//   the rows are kept, so the selection and scroll position stay
 bool
 ProcessProperties::refresh()
 {
-    auto sel = m_procTree->get_selection();
-    auto iterSel = sel->get_selected();
-    pProcess selectedProcess;
-    if (iterSel) {      // save selection if valid
-        auto row = *iterSel;
-        selectedProcess = row.get_value(m_propertyColumns->m_process);
-        //std::cout << "selectedProcess " << selectedProcess->getName() << std::endl;
-    }
-    m_processes->update();  // use our own model as we get a garbled display if we are messing with the live time of main processes (side effect synced update, but hight effort to scan all)
-    m_properties->clear();
-    auto process = m_processes->findPid(m_processId);
+    auto snapshot = m_processes->getSnapshot();
+    if (!snapshot) {
+        return true;    // wait for the first
+    }
+    const bool changed = snapshot != m_snapshot;
+    if (!changed && m_threadSampler.empty()) {
+        return true;
+    }
+    m_snapshot = snapshot;
+    if (changed) {
+        markShown();
+    }
+    if (!m_threadSampler.empty()) {
+        m_threadSampler.sample(m_reader);
+    }
+    ++m_generation;
+    auto process = m_snapshot->find(m_processId);
     if (process) {
-        auto iterChld = m_properties->append();
-        addProcess(iterChld, process);
-        m_procTree->expand_all();   // required for selection to work
-        if (selectedProcess) {
-            Gtk::TreeNodeChildren chlds = m_properties->children();
-            for (auto iter = chlds.begin(); iter != chlds.end(); ++iter) {
-                selectProcess(iter, selectedProcess);
+        updateProcess(Gtk::TreeModel::iterator(), *process);
+        m_rows.eraseIf([this] (ProcessRow& processRow) {
+            if (processRow.generation != m_generation) {    // exited or not shown
+                if (processRow.ref.is_valid()) {    // invalid if the parent was removed
+                    m_properties->erase(m_properties->get_iter(processRow.ref.get_path()));
+                }
+                return true;
             }
-        }
+            return false;
+        });
         return true;
     }
     return false;   // if not found no use of keep updating
 }
 
+// the names are shared with the processes
 Glib::ustring
 ProcessProperties::getUid2Name(uint32_t uid)
 {
-    auto entry = m_users.find(uid); // lookup cache as the following might be expensive
-    if (entry != m_users.end()) {
-        return entry->second;
-    }
-    Glib::ustring userName;
-    struct passwd *pws = getpwuid(uid);
-    if (pws != nullptr) {
-        userName = Glib::ustring(pws->pw_name);
-    }
-    userName += Glib::ustring::sprintf(" (%d)", uid);
-    m_users.insert(std::pair(uid, userName));
-    return userName;
+    return Glib::ustring::sprintf("%s (%d)", NamePool::userName(uid), uid);
 }
 
 Glib::ustring
 ProcessProperties::getGid2Name(uint32_t gid)
 {
-    auto entry = m_groups.find(gid);   // lookup cache as the following might be expensive
-    if (entry != m_groups.end()) {
-        return entry->second;
-    }
-    Glib::ustring groupName;
-    struct group *grp = getgrgid(gid);
-    if (grp != nullptr) {
-        groupName = Glib::ustring(grp->gr_name);
-    }
-    groupName += Glib::ustring::sprintf(" (%d)", gid);
-    m_groups.insert(std::pair(gid, groupName));
-    return groupName;
+    return Glib::ustring::sprintf("%s (%d)", NamePool::groupName(gid), gid);
 }
 
 ProcessProperties*
-ProcessProperties::show(const long processId, Glib::KeyFile* keyFile, int32_t update_interval)
+ProcessProperties::show(const long processId, ProcessesBase* processes, Glib::KeyFile* keyFile, int32_t update_interval)
 {
     ProcessProperties* procProp = nullptr;
     auto refBuilder = Gtk::Builder::create();
@@ -244,7 +379,7 @@ ProcessProperties::show(const long processId, Glib::KeyFile* keyFile, int32_t up
         auto appl = Glib::RefPtr<Gtk::Application>::cast_dynamic(gappl);
         refBuilder->add_from_resource(
             appl->get_resource_base_path() + "/process_properties.ui");
-        refBuilder->get_widget_derived("proc-prop-dlg", procProp, processId, keyFile, update_interval);
+        refBuilder->get_widget_derived("proc-prop-dlg", procProp, processId, processes, keyFile, update_interval);
         if (procProp) {
             procProp->set_transient_for(*appl->get_active_window());
             /*int ret =*/
@@ -25,6 +25,8 @@
 #include <KeyfileTableManager.hpp>
 
 #include "ProcessesBase.hpp"
+#include "ThreadSampler.hpp"
+#include "ProcessFilter.hpp"
 
 class Process;
 
@@ -102,10 +104,12 @@ public:
     Gtk::TreeModelColumn<glong> m_rssAnon;
     Gtk::TreeModelColumn<glong> m_rssFile;
     Gtk::TreeModelColumn<glong> m_threads;
+    Gtk::TreeModelColumn<gulong> m_ioRead;
+    Gtk::TreeModelColumn<gulong> m_ioWrite;
+    Gtk::TreeModelColumn<gulong> m_ctxtSwitches;
     Gtk::TreeModelColumn<Glib::ustring> m_user;
     Gtk::TreeModelColumn<Glib::ustring> m_group;
     Gtk::TreeModelColumn<Glib::ustring> m_state;
-    Gtk::TreeModelColumn<pProcess> m_process;
 
     ProcessColumns()
     {
@@ -130,11 +134,14 @@ public:
         auto sizeRssFileConverter = std::make_shared<KSizeConverter>(m_rssFile);
         add<glong>("RSSFile", sizeRssFileConverter, 1.0f);
         add<glong>("Threads", m_threads, 1.0f);
+        auto sizeIoReadConverter = std::make_shared<USizeConverter>(m_ioRead);
+        add<gulong>("IORead", sizeIoReadConverter, 1.0f);
+        auto sizeIoWriteConverter = std::make_shared<USizeConverter>(m_ioWrite);
+        add<gulong>("IOWrite", sizeIoWriteConverter, 1.0f);
+        add<gulong>("CtxtSwitches", m_ctxtSwitches, 1.0f);
         add<Glib::ustring>("User", m_user, 1.0f);
         add<Glib::ustring>("Group", m_group, 1.0f);
         add<Glib::ustring>("State", m_state, 1.0f);
-        // keep this as last, for not confuse indexing of additional infos
-        Gtk::TreeModel::ColumnRecord::add(m_process);     // this will not be visible, so use std. function
     }
     virtual ~ProcessColumns() = default;
 };
@@ -144,31 +151,51 @@ class ProcessProperties
 : public Gtk::Dialog
 {
 public:
-    ProcessProperties(BaseObjectType* cobject, const Glib::RefPtr<Gtk::Builder>& builder, const long processId, Glib::KeyFile* keyFile, int32_t update_interval);
+    // the processes are used for the snapshot they publish, these have to outlive the dialog
+    ProcessProperties(BaseObjectType* cobject, const Glib::RefPtr<Gtk::Builder>& builder, const long processId, ProcessesBase* processes, Glib::KeyFile* keyFile, int32_t update_interval);
     explicit ProcessProperties(const ProcessProperties& orig) = delete;
-    virtual ~ProcessProperties() = default;
-    static ProcessProperties* show(const long processId, Glib::KeyFile* keyFile, int32_t update_interval);
+    virtual ~ProcessProperties();
+    static ProcessProperties* show(const long processId, ProcessesBase* processes, Glib::KeyFile* keyFile, int32_t update_interval);
 protected:
-    void addProcess(const Gtk::TreeModel::iterator& i, pProcess& process);
-    bool selectProcess(const Gtk::TreeModel::iterator& i, pProcess& selectedProcess);
+    void updateProcess(const Gtk::TreeModel::iterator& parent, const ProcessInfo& process);
+    void setValues(const Gtk::TreeModel::Row& row, const ProcessInfo& process);
+    void markShown();
+    uint32_t updateThreads(const Gtk::TreeModel::Row& row, long pid, uint32_t threads);
     bool refresh();
     Glib::ustring getUid2Name(uint32_t uid);
     Glib::ustring getGid2Name(uint32_t gid);
     void stopProcess();
     void on_response(int response_id) override;
     void showNetwork();
+    void sampleThreads();
+    void applyFilter();
     static constexpr auto CONFIG_GRP = "ProcessProperties";
 private:
-    std::shared_ptr<ProcessesBase> m_processes;
+    struct ProcessRow
+    {
+        unsigned long long startTime;   // to detect a reused pid
+        Gtk::TreeRowReference ref;
+        uint32_t generation;    // the refresh that visited the row
+        uint32_t threads;       // thread rows in front of the children
+    };
+    ProcessesBase* m_processes;
+    std::shared_ptr<const ProcessSnapshot> m_snapshot;
+    std::shared_ptr<const ProcessFilter> m_filter;
+    std::vector<bool> m_shown;          // by snapshot index, empty shows all
     long m_processId;
     Glib::KeyFile* m_keyFile;
     int32_t m_update_interval;
     Glib::RefPtr<Gtk::TreeStore> m_properties;
+    PidMap<ProcessRow> m_rows;          // by pid, to update the rows in place
+    uint32_t m_generation;
     sigc::connection m_timer;               /* Timer for regular updates */
-    std::map<uint32_t, Glib::ustring> m_users;
-    std::map<uint32_t, Glib::ustring> m_groups;
     Glib::RefPtr<Gtk::TreeView> m_procTree;
     std::shared_ptr<ProcessColumns> m_propertyColumns;
     std::shared_ptr<psc::ui::KeyfileTableManager> m_kfTableManager;
+    Glib::RefPtr<Gtk::ToggleButton> m_threadsButton;
+    ThreadSampler m_threadSampler;  // on demand for the selected process
+    ProcReader m_reader;
+    std::vector<const ThreadSampler::Thread*> m_threads;
+    Glib::RefPtr<Gtk::SearchEntry> m_filterEntry;
 };
 
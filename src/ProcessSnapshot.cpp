@@ -0,0 +1,83 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ProcessSnapshot.hpp"
+#include "Process.hpp"
+
+ProcessInfo::ProcessInfo(const Process& process)
+: m_pid{process.getPid()}
+, m_ppid{process.getPpid()}
+, m_name{process.getSharedName()}
+, m_startTime{process.getStartTime()}
+, m_state{process.getState()}
+, m_uid{process.getUid()}
+, m_gid{process.getGid()}
+, m_load{process.getRawLoad()}
+, m_vmPeakK{process.getVmPeakK()}
+, m_vmSizeK{process.getVmSizeK()}
+, m_vmDataK{process.getVmDataK()}
+, m_vmStackK{process.getVmStackK()}
+, m_vmExecK{process.getVmExecK()}
+, m_vmRssK{process.getVmRssK()}
+, m_rssAnonK{process.getRssAnonK()}
+, m_rssFileK{process.getRssFileK()}
+, m_threads{process.getThreads()}
+, m_ioReadBytes{process.getIoReadBytes()}
+, m_ioWriteBytes{process.getIoWriteBytes()}
+, m_ctxtSwitches{process.getVoluntaryCtxt() + process.getNonvoluntaryCtxt()}
+, m_parent{ProcessSnapshot::NONE}
+, m_firstChild{ProcessSnapshot::NONE}
+, m_nextSibling{ProcessSnapshot::NONE}
+{
+}
+
+ProcessSnapshot::ProcessSnapshot(uint64_t serial, size_t reserve)
+: m_serial{serial}
+{
+    m_processes.reserve(reserve);
+}
+
+void
+ProcessSnapshot::add(const Process& process)
+{
+    m_index.insert(static_cast<pid_t>(process.getPid()), static_cast<uint32_t>(m_processes.size()));
+    m_processes.emplace_back(process);
+}
+
+// the children are linked in reverse order of adding
+void
+ProcessSnapshot::link()
+{
+    for (uint32_t i = 0; i < m_processes.size(); ++i) {
+        auto& info = m_processes[i];
+        auto parent = m_index.find(static_cast<pid_t>(info.m_ppid));
+        if (parent && *parent != i) {
+            auto& parentInfo = m_processes[*parent];
+            info.m_parent = *parent;
+            info.m_nextSibling = parentInfo.m_firstChild;
+            parentInfo.m_firstChild = i;
+        }
+    }
+}
+
+const ProcessInfo*
+ProcessSnapshot::find(long pid) const
+{
+    auto index = m_index.find(static_cast<pid_t>(pid));
+    return index ? &m_processes[*index] : nullptr;
+}
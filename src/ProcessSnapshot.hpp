@@ -0,0 +1,200 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <sys/types.h>
+#include <string>
+#include <vector>
+#include <cstdint>
+
+#include "NamePool.hpp"
+#include "PidMap.hpp"
+
+class Process;
+
+// the values of a process at one update (see ProcessSnapshot),
+//   the getters are named as those of Process
+class ProcessInfo
+{
+public:
+    explicit ProcessInfo(const Process& process);
+
+    long getPid() const
+    {
+        return m_pid;
+    }
+    long getPpid() const
+    {
+        return m_ppid;
+    }
+    const std::string& getInternedName() const
+    {
+        return *m_name;
+    }
+    unsigned long long getStartTime() const
+    {
+        return m_startTime;
+    }
+    char getState() const
+    {
+        return m_state;
+    }
+    uint32_t getUid() const
+    {
+        return m_uid;
+    }
+    uint32_t getGid() const
+    {
+        return m_gid;
+    }
+    double getRawLoad() const
+    {
+        return m_load;
+    }
+    long getVmPeakK() const
+    {
+        return m_vmPeakK;
+    }
+    long getVmSizeK() const
+    {
+        return m_vmSizeK;
+    }
+    long getVmDataK() const
+    {
+        return m_vmDataK;
+    }
+    long getVmStackK() const
+    {
+        return m_vmStackK;
+    }
+    long getVmExecK() const
+    {
+        return m_vmExecK;
+    }
+    long getVmRssK() const
+    {
+        return m_vmRssK;
+    }
+    long getRssAnonK() const
+    {
+        return m_rssAnonK;
+    }
+    long getRssFileK() const
+    {
+        return m_rssFileK;
+    }
+    long getThreads() const
+    {
+        return m_threads;
+    }
+    uint64_t getIoReadBytes() const
+    {
+        return m_ioReadBytes;
+    }
+    uint64_t getIoWriteBytes() const
+    {
+        return m_ioWriteBytes;
+    }
+    uint64_t getCtxtSwitches() const
+    {
+        return m_ctxtSwitches;
+    }
+    // indexes into the snapshot, ProcessSnapshot::NONE at the end
+    uint32_t getParent() const
+    {
+        return m_parent;
+    }
+    uint32_t getFirstChild() const
+    {
+        return m_firstChild;
+    }
+    uint32_t getNextSibling() const
+    {
+        return m_nextSibling;
+    }
+private:
+    friend class ProcessSnapshot;
+
+    long m_pid;
+    long m_ppid;
+    NamePool::Name m_name;          // interned
+    unsigned long long m_startTime;
+    char m_state;
+    uint32_t m_uid;
+    uint32_t m_gid;
+    double m_load;
+    long m_vmPeakK;
+    long m_vmSizeK;
+    long m_vmDataK;
+    long m_vmStackK;
+    long m_vmExecK;
+    long m_vmRssK;
+    long m_rssAnonK;
+    long m_rssFileK;
+    long m_threads;
+    uint64_t m_ioReadBytes;
+    uint64_t m_ioWriteBytes;
+    uint64_t m_ctxtSwitches;
+    uint32_t m_parent;
+    uint32_t m_firstChild;
+    uint32_t m_nextSibling;
+};
+
+// the processes of one update, the tree is linked by ppid.
+//   Built by the scanner and then only used as const, so it can be shared
+//   by any number of consumers (on any thread) without scanning themselves.
+class ProcessSnapshot
+{
+public:
+    ProcessSnapshot(uint64_t serial, size_t reserve = 0u);
+    explicit ProcessSnapshot(const ProcessSnapshot& orig) = delete;
+    virtual ~ProcessSnapshot() = default;
+
+    // building, call link after the last add
+    void add(const Process& process);
+    void link();
+
+    const ProcessInfo* find(long pid) const;
+    const ProcessInfo& get(uint32_t index) const
+    {
+        return m_processes[index];
+    }
+    uint32_t indexOf(const ProcessInfo& info) const
+    {
+        return static_cast<uint32_t>(&info - m_processes.data());
+    }
+    const std::vector<ProcessInfo>& getProcesses() const
+    {
+        return m_processes;
+    }
+    size_t size() const
+    {
+        return m_processes.size();
+    }
+    // increases with each published snapshot
+    uint64_t getSerial() const
+    {
+        return m_serial;
+    }
+    static constexpr uint32_t NONE{UINT32_MAX};
+private:
+    uint64_t m_serial;
+    std::vector<ProcessInfo> m_processes;
+    PidMap<uint32_t> m_index;
+};
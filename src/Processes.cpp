@@ -16,6 +16,7 @@
  */
 
 #include <iostream>
+#include <algorithm>
 #include <TreeNode2.hpp>
 #include <LineShapeRenderer2.hpp>
 #include <SunDiscRenderer2.hpp>
@@ -26,9 +27,15 @@
 
 Processes::Processes(uint32_t _size)
 : ProcessesBase{}
+, m_topCount{0u}
 , m_size{_size}
+, m_history{std::make_shared<ProcessHistory>(_size)}
+, m_memDetailInterval{0u}
+, m_memDetailTicks{0u}
 , m_treeType{TreeType::ARC}
+, m_dataChanged{true}
 {
+    setTopCount(TOP_PROC);
 }
 
 
@@ -42,6 +49,10 @@ Processes::~Processes()
         m_textCpu[i].resetAll();
         m_textMem[i].resetAll();
     }
+    for (uint32_t i = 0; i < m_ioGeo.size(); ++i) {
+        m_ioGeo[i].resetAll();
+        m_textIo[i].resetAll();
+    }
 }
 
 void
@@ -57,6 +68,9 @@ Processes::resetProc()
             topCpu.reset();
         }
     }
+    for (auto& topIo : m_topIo) {
+        topIo.reset();
+    }
 }
 
 void
@@ -65,8 +79,7 @@ Processes::printInfo()
 	unsigned long sumMemUsage = 0;
 	unsigned long sumMemGraph = 0;
 
-	for (auto p : mProcesses) {
-		pProcess proc = p.second;
+	for (auto& proc : mProcesses) {
 		sumMemUsage += proc->getMemUsage();
 		sumMemGraph += proc->getMemGraph();
 	}
@@ -74,61 +87,174 @@ Processes::printInfo()
 	std::cout <<  "all process memGraph " << sumMemGraph << std::endl;
 }
 
+// on the sampler thread, the cgroups are read here as well
+void
+Processes::sample()
+{
+    ProcessesBase::sample();
+    if (m_cgroups
+     && !m_cgroups->update()) {
+        psc::log::Log::logAdd(psc::log::Level::Warn, "No cgroup v2 hierarchy found");
+        m_cgroups.reset();
+    }
+}
+
 void
 Processes::update(std::shared_ptr<Monitor> cpu, std::shared_ptr<Monitor> mem)
 {
-    ProcessesBase::update();
-    for (auto& p : mProcesses) {
-        auto proc = p.second;
+    ProcessesBase::present();
+    m_history->roll();
+    for (auto& proc : mProcesses) {
         proc->update(cpu, mem);
     }
-    findMax(m_topMem, m_topCpu);
+    findMax(m_topMem, m_topCpu, m_topIo);
+    updateMemDetail();
+    publishSnapshot();      // with the load of this update
+    m_dataChanged = true;
+}
+
+void
+Processes::setMemDetailInterval(uint32_t interval)
+{
+    m_memDetailInterval = interval;
+    if (m_memDetailInterval == 0u) {
+        m_memDetail.reset();
+    }
+    else if (!m_memDetail) {
+        m_memDetail = std::make_unique<MemDetailCollector>();
+    }
+}
+
+// the results are applied here (on the main thread) so the process
+//   gets pss, uss and swap consistent, and is only found if it is still alive
+void
+Processes::updateMemDetail()
+{
+    if (!m_memDetail) {
+        return;
+    }
+    if (m_memDetail->take(m_memDetails)) {
+        for (auto& detail : m_memDetails) {
+            auto proc = findPid(detail.pid);
+            if (proc) {
+                proc->setMemDetail(detail.pssK, detail.ussK, detail.swapK);
+            }
+        }
+    }
+    if (m_memDetailTicks % m_memDetailInterval == 0u) {
+        m_memDetailPids.clear();
+        for (auto& proc : m_topMem) {
+            if (proc) {
+                m_memDetailPids.push_back(static_cast<pid_t>(proc->getPid()));
+            }
+        }
+        if (!m_memDetail->request(m_memDetailPids)) {
+            return;     // still reading, retry with the next update
+        }
+    }
+    ++m_memDetailTicks;
+}
+
+void
+Processes::setTopCount(uint32_t topCount)
+{
+    m_topCount = std::clamp(topCount, 1u, MAX_TOP_PROC);
+    m_topMem.resize(m_topCount);
+    m_topCpu.resize(m_topCount);
+    m_topIo.resize(m_topCount);
+    m_cpuColors.resize(m_topCount);
+    m_memColors.resize(m_topCount);
+    m_ioColors.resize(m_topCount);
+    for (uint32_t i = 0; i < m_topCount; ++i) {     // these only change with the count
+        m_cpuColors[i] = topColor(Gdk::RGBA("#a04000"), Gdk::RGBA("#800000"), i);   // working heat -> red
+        m_memColors[i] = topColor(Gdk::RGBA("#4000a0"), Gdk::RGBA("#000080"), i);   // mem -> blue
+        m_ioColors[i] = topColor(Gdk::RGBA("#00a040"), Gdk::RGBA("#008000"), i);    // io -> green
+    }
 }
 
 void
-Processes::findMax(std::array<pProcess, TOP_PROC>& topMem
-                  ,std::array<pProcess, TOP_PROC>& topCpu)
+Processes::setCollectIo(bool collectIo)
 {
-    std::vector<pProcess> procs(mProcesses.size());
-    for (auto& p : mProcesses) {
-        auto proc = p.second;
+    m_history->setEnabled(ProcessHistory::IO, collectIo);
+    ProcessesBase::setCollectIo(collectIo);
+}
+
+// select the tops in one pass, the keys are evaluated once for each process
+//   (the cpu/io usage sums the buffer)
+void
+Processes::findMax(std::vector<pProcess>& topMem
+                  ,std::vector<pProcess>& topCpu
+                  ,std::vector<pProcess>& topIo)
+{
+    const bool collectIo = isCollectIo();
+    m_selectMem.reset(topMem.size());
+    m_selectCpu.reset(topCpu.size());
+    m_selectIo.reset(collectIo ? topIo.size() : 0u);
+    for (auto& proc : mProcesses) {
         if (proc && proc->isActive()) {
-            procs.push_back(proc);
+            m_selectMem.add(proc->getMemUsage(), &proc);
+            m_selectCpu.add(proc->getCpuUsageBuf(), &proc);
+            if (collectIo) {
+                double io = proc->getIoUsageBuf();
+                if (io > 0.0) {     // idle processes would only fill the list
+                    m_selectIo.add(io, &proc);
+                }
+            }
         }
     }
-    std::sort(procs.begin(), procs.end(), CompareByMem());
-    uint32_t i = 0;
-    //std::cout << "Memory" << std::endl;
-    for (auto& pro : procs) {
-        //std::wcout << i << " " << pro->getDisplayName() << " " <<  pro->getMemUsage() << std::endl;
-        topMem[i++] = pro;
-        if (i >= topMem.size()) {
-            break;
+    auto& mems = m_selectMem.sorted();
+    for (size_t i = 0; i < topMem.size(); ++i) {
+        if (i < mems.size()) {
+            topMem[i] = *mems[i].value;
+        }
+        else {
+            topMem[i].reset();
         }
     }
-    std::sort(procs.begin(), procs.end(), CompareByCpu());
-    i = 0;
-    //std::cout << "Cpu" << std::endl;
-    for (auto& pro : procs) {
-        //std::wcout << i << " " << pro->getDisplayName() << " " <<  pro->getCpuUsage() << " fl: " << pro->getCpuUsageBuf() << std::endl;
-        topCpu[i++] = pro;
-        if (i >= topCpu.size()) {
-            break;
+    auto& cpus = m_selectCpu.sorted();
+    for (size_t i = 0; i < topCpu.size(); ++i) {
+        if (i < cpus.size()) {
+            topCpu[i] = *cpus[i].value;
+        }
+        else {
+            topCpu[i].reset();
+        }
+    }
+    auto& ios = m_selectIo.sorted();
+    for (size_t i = 0; i < topIo.size(); ++i) {
+        if (i < ios.size()) {
+            topIo[i] = *ios[i].value;
+        }
+        else {
+            topIo[i].reset();
         }
     }
 }
 
+// shade between first and last for the number of tops
+Gdk::RGBA
+Processes::topColor(const Gdk::RGBA& first, const Gdk::RGBA& last, uint32_t i)
+{
+    double f = m_topCount > 1u ? static_cast<double>(i) / static_cast<double>(m_topCount - 1u) : 0.0;
+    Gdk::RGBA color;
+    color.set_rgba(first.get_red() + (last.get_red() - first.get_red()) * f
+                 , first.get_green() + (last.get_green() - first.get_green()) * f
+                 , first.get_blue() + (last.get_blue() - first.get_blue()) * f);
+    return color;
+}
+
 void
 Processes::updateCpu(GraphShaderContext* pGraph_shaderContext,
 	TextContext *_txtCtx, const psc::gl::ptrFont2& pFont, std::shared_ptr<DiagramMonitor> cpu,
 	Matrix &persView, Position &p)
 {
-    Gdk::RGBA colors[3];
-    colors[0] = Gdk::RGBA("#a04000");   // working heat -> red
-    colors[1] = Gdk::RGBA("#902000");
-    colors[2] = Gdk::RGBA("#800000");
-    if (!m_cpuGeo[0]) {
-        for (uint32_t i = 0; i < Processes::TOP_PROC; ++i) {
+    auto& colors = m_cpuColors;
+    // keep the height of the default list
+    const float step = 0.3f * static_cast<float>(TOP_PROC) / static_cast<float>(std::max(m_topCount, TOP_PROC));
+    if (m_cpuGeo.empty()) {
+        m_cpuGeo.resize(m_topCount);
+        m_textCpu.resize(m_topCount);
+        for (uint32_t i = 0; i < m_topCount; ++i) {
             m_cpuGeo[i] = createBox(pGraph_shaderContext, colors[i]);
             pGraph_shaderContext->addGeometry(m_cpuGeo[i]);
             auto lcpuGeo = m_cpuGeo[i].lease();
@@ -138,17 +264,17 @@ Processes::updateCpu(GraphShaderContext* pGraph_shaderContext,
                 auto ltextCpu = m_textCpu[i].lease();
                 if (ltextCpu) {
                     ltextCpu->setTextContext(_txtCtx);
-                    ltextCpu->setScale(0.005f);
+                    ltextCpu->setScale(0.005f * step / 0.3f);
                     Position p2(0.25f, 0.0f, 0.0f);
                     ltextCpu->setPosition(p2);
                 }
                 lcpuGeo->addGeometry(m_textCpu[i]);
             }
-            p.y -= 0.3f;
+            p.y -= step;
         }
     }
     auto sum = std::make_shared<Buffer<double>>(m_size);
-    for (uint32_t i = 0; i < Processes::TOP_PROC; ++i) {
+    for (uint32_t i = 0; i < m_topCount; ++i) {
         auto proc = m_topCpu[i];
         if (proc) {
             //bool duplicat = FALSE;
@@ -158,9 +284,8 @@ Processes::updateCpu(GraphShaderContext* pGraph_shaderContext,
             //        duplicat = TRUE;      // process is in both lists -> dont display list entry again
             //    }
             //}
-            auto values = proc->getCpuData();
-            sum->add(values);    // Stack graphs
-            cpu->fill_buffers(cpu->getMonitor()->defaultValues()+i, sum, &colors[i]);
+            proc->addCpuData(*sum);    // Stack graphs
+            cpu->fill_values(cpu->getMonitor()->defaultValues()+i, sum, &colors[i]);
             //if (!duplicat) {
             auto geo = m_cpuGeo[i];
             if (geo) {
@@ -181,14 +306,14 @@ Processes::updateCpu(GraphShaderContext* pGraph_shaderContext,
 void
 Processes::updateMem(GraphShaderContext* pGraph_shaderContext,
 	TextContext *_txtCtx, const psc::gl::ptrFont2& pFont,
-	std::shared_ptr<DiagramMonitor> mem, Matrix &persView, Position &p)
+	std::shared_ptr<DiagramMonitor> mem, const DiagramMonitor& cpu, Matrix &persView, Position &p)
 {
-    Gdk::RGBA colors[Processes::TOP_PROC];
-    colors[0] = Gdk::RGBA("#4000a0");   // mem -> blue
-    colors[1] = Gdk::RGBA("#200090");
-    colors[2] = Gdk::RGBA("#000080");
-    if (!m_memGeo[0]) {
-        for (uint32_t i = 0; i < Processes::TOP_PROC; ++i) {
+    auto& colors = m_memColors;
+    const float step = 0.3f * static_cast<float>(TOP_PROC) / static_cast<float>(std::max(m_topCount, TOP_PROC));
+    if (m_memGeo.empty()) {
+        m_memGeo.resize(m_topCount);
+        m_textMem.resize(m_topCount);
+        for (uint32_t i = 0; i < m_topCount; ++i) {
             m_memGeo[i] = createBox(pGraph_shaderContext, colors[i]);
             pGraph_shaderContext->addGeometry(m_memGeo[i]);
             auto lmemGeo = m_memGeo[i].lease();
@@ -198,30 +323,36 @@ Processes::updateMem(GraphShaderContext* pGraph_shaderContext,
                 auto lTextMem = m_textMem[i].lease();
                 if (lTextMem) {
                      lTextMem->setTextContext(_txtCtx);
-                    lTextMem->setScale(0.0045f);
+                    lTextMem->setScale(0.0045f * step / 0.3f);
                     Position p2(0.25f, 0.0f, 0.0f);
                     lTextMem->setPosition(p2);
                 }
                 lmemGeo->addGeometry(m_textMem[i]);
             }
-            p.y -= 0.3f;
+            p.y -= step;
         }
     }
 
     auto sum = std::make_shared<Buffer<double>>(m_size);
-    for (uint32_t i = 0; i < Processes::TOP_PROC; ++i) {
+    for (uint32_t i = 0; i < m_topCount; ++i) {
         pProcess proc = m_topMem[i];
         if (proc) {
-            auto values = proc->getMemData();
-            sum->add(values);    // stack graphs
-            mem->fill_buffers(mem->getMonitor()->defaultValues()+i, sum, &colors[i]);
+            proc->addMemData(*sum);    // stack graphs
+            mem->fill_values(mem->getMonitor()->defaultValues()+i, sum, &colors[i], cpu);
             auto geo = m_memGeo[i];
             if (geo) {
                 //std::cout << "x " << x << " name " << proc->getName() << std::endl;
                 //Matrix mvp = pGraph_shaderContext->setScalePos(persView, p, 1.0f);
                 //geo->display(persView);
-                double procMb = proc->getMemUsage() / 1024.0;
-                auto buffer = Glib::ustring::sprintf("%s %.1lfM", proc->getDisplayName(), procMb);
+                Glib::ustring buffer;
+                if (proc->getPssK() > 0) {  // the proportional share is closer to what is freed on exit
+                    double pssMb = static_cast<double>(proc->getPssK()) / 1024.0;
+                    buffer = Glib::ustring::sprintf("%s %.1lfM pss", proc->getDisplayName(), pssMb);
+                }
+                else {
+                    double procMb = proc->getMemUsage() / 1024.0;
+                    buffer = Glib::ustring::sprintf("%s %.1lfM", proc->getDisplayName(), procMb);
+                }
                 auto ltxtMem = m_textMem[i].lease();
                 if (ltxtMem) {
                     ltxtMem->setText(buffer);
@@ -232,35 +363,123 @@ Processes::updateMem(GraphShaderContext* pGraph_shaderContext,
     }
 }
 
+// the io is stacked on the disk diagram,
+//   as the process io is counted per update (and includes e.g. network filesystems)
+//   the stack is scaled to its own maximum
+void
+Processes::updateIo(GraphShaderContext* pGraph_shaderContext,
+	TextContext *_txtCtx, const psc::gl::ptrFont2& pFont,
+	std::shared_ptr<DiagramMonitor> disk, const DiagramMonitor& cpu, Matrix &persView, Position &p)
+{
+    auto& colors = m_ioColors;
+    const float step = 0.3f * static_cast<float>(TOP_PROC) / static_cast<float>(std::max(m_topCount, TOP_PROC));
+    if (m_ioGeo.empty()) {
+        m_ioGeo.resize(m_topCount);
+        m_textIo.resize(m_topCount);
+        for (uint32_t i = 0; i < m_topCount; ++i) {
+            m_ioGeo[i] = createBox(pGraph_shaderContext, colors[i]);
+            pGraph_shaderContext->addGeometry(m_ioGeo[i]);
+            auto lioGeo = m_ioGeo[i].lease();
+            if (lioGeo) {
+                lioGeo->setPosition(p);
+                m_textIo[i] = psc::mem::make_active<psc::gl::Text2>(GL_TRIANGLES, pGraph_shaderContext, pFont);
+                auto ltextIo = m_textIo[i].lease();
+                if (ltextIo) {
+                    ltextIo->setTextContext(_txtCtx);
+                    ltextIo->setScale(0.0045f * step / 0.3f);
+                    Position p2(0.25f, 0.0f, 0.0f);
+                    ltextIo->setPosition(p2);
+                }
+                lioGeo->addGeometry(m_textIo[i]);
+            }
+            p.y -= step;
+        }
+    }
+    auto total = std::make_shared<Buffer<double>>(m_size);
+    for (auto& proc : m_topIo) {
+        if (proc) {
+            proc->addIoData(*total, 1.0);
+        }
+    }
+    double max{};
+    for (uint32_t i = 0; i < m_size; ++i) {
+        max = std::max(max, total->get(i));
+    }
+    const double scale = max > 0.0 ? 1.0 / max : 0.0;
+    auto sum = std::make_shared<Buffer<double>>(m_size);
+    for (uint32_t i = 0; i < m_topCount; ++i) {
+        pProcess proc = m_topIo[i];
+        auto ltxtIo = m_textIo[i].lease();
+        if (proc) {
+            proc->addIoData(*sum, scale);    // stack graphs
+        }
+        // fewer processes with io than shown, collapse the graph on the previous
+        disk->fill_values(disk->getMonitor()->defaultValues()+i, sum, &colors[i], cpu);
+        if (ltxtIo) {
+            ltxtIo->setText(proc ? proc->getDisplayName() : Glib::ustring());
+        }
+    }
+}
+
 void
 Processes::setTreeType(const Glib::ustring &uProcessType)
 {
     TreeType treeType = Processes::fromString(uProcessType);
-    for (auto p : mProcesses) {    // delete previous geometries
-        pProcess proc = p.second;
+    for (auto& proc : mProcesses) {    // delete previous geometries
         proc->removeGeometry();
     }
+    if (m_cgroups) {
+        m_cgroups->removeGeometry();
+    }
+    if (treeType == TreeType::CGROUP) {
+        if (!m_cgroups) {
+            m_cgroups = std::make_unique<CgroupCollector>(m_size);
+        }
+    }
+    else {
+        m_cgroups.reset();
+    }
     m_treeType = treeType;
 }
 
+// the geometry is created from the process values, so this is done with the update
+//   (not on display, as the sampler may change the processes meanwhile)
 void
-Processes::display(
+Processes::updateGeometry(
             GraphShaderContext *pGraph_shaderContext
           , TextContext *_txtCtx
           , const psc::gl::ptrFont2& pFont
           , std::shared_ptr<DiagramMonitor> cpu
           , std::shared_ptr<DiagramMonitor> mem
+          , std::shared_ptr<DiagramMonitor> disk
           , Matrix &persView)
 {
     Position p(1.5f, 4.3f, 0.0f);
     updateCpu(pGraph_shaderContext, _txtCtx, pFont, cpu, persView, p);
-    updateMem(pGraph_shaderContext, _txtCtx, pFont, mem, persView, p);
-    displayTops(pGraph_shaderContext, persView);
+    updateMem(pGraph_shaderContext, _txtCtx, pFont, mem, *cpu, persView, p);
+    if (disk
+     && isCollectIo()) {
+        updateIo(pGraph_shaderContext, _txtCtx, pFont, disk, *cpu, persView, p);
+    }
 
-    if (m_procRoot) {
+    // the geometry depends on the loads and the tree, so only recreate it if these changed
+    std::shared_ptr<psc::gl::TreeNode2> root = m_procRoot;
+    bool treeChanged = isTreeChanged();
+    if (m_cgroups) {
+        root = m_cgroups->getRoot();
+        treeChanged = m_cgroups->isTreeChanged();
+    }
+    if (root
+     && (m_dataChanged || treeChanged || !root->getTreeGeometry())) {
+        m_dataChanged = false;
+        setTreeChanged(false);
+        if (m_cgroups) {
+            m_cgroups->setTreeChanged(false);
+        }
         Position pos(-5.0f, -4.0f, -2.5f);      // fallshape (left edge)
         std::shared_ptr<psc::gl::TreeRenderer2> treeRenderer;
         switch (m_treeType) {
+        case TreeType::CGROUP:
         case TreeType::ARC:
             pos = Position(0.0f, -5.0f, 0.0f);  // sundisc (center)
             treeRenderer = std::make_shared<psc::gl::SunDiscRenderer2>();
@@ -273,8 +492,8 @@ Processes::display(
             break;
         }
         if (treeRenderer) {
-            auto lastRootGeom = m_procRoot->getTreeGeometry();
-            auto geo = treeRenderer->create(m_procRoot, pGraph_shaderContext, _txtCtx, pFont);
+            auto lastRootGeom = root->getTreeGeometry();
+            auto geo = treeRenderer->create(root, pGraph_shaderContext, _txtCtx, pFont);
             if (lastRootGeom != geo) {
                 if (lastRootGeom) {
                     pGraph_shaderContext->removeGeometry(lastRootGeom.get());
@@ -325,10 +544,8 @@ Processes::restore()
     Position pos(0.0f);
     Rotational rot(0.0f, 0.0f, 0.0f);    // angels need (also set in geometry constr.) leads to expanded tree otherwise
 
-    for (auto& p : mProcesses) {
-        auto pid = p.first;
-        if (pid != ROOT_PID) {  // reset position for all but first
-            auto& proc = p.second;
+    for (auto& proc : mProcesses) {
+        if (proc->getPid() != ROOT_PID) {  // reset position for all but first
             auto geo = proc->getTreeGeometry();
             if (geo) {
                 auto lgeo = geo.lease();
@@ -345,7 +562,7 @@ Processes::restore()
 pProcess
 Processes::createProcess(std::string path, long pid)
 {
-    return std::make_shared<Process>(path, pid, m_size);
+    return std::make_shared<Process>(path, pid, m_history);
 }
 
 void
@@ -363,4 +580,10 @@ Processes::displayTops(NaviContext* context, const Matrix &projView)
             lcpu->display(context, projView);
         }
     }
+    for (auto& io : m_ioGeo) {
+        auto lio = io.lease();
+        if (lio) {
+            lio->display(context, projView);
+        }
+    }
 }
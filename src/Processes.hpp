@@ -22,18 +22,22 @@
 #pragma once
 
 #include <memory>
-#include <array>
+#include <vector>
 
 #include "GraphShaderContext.hpp"
 #include "Font2.hpp"
 #include "DiagramMonitor.hpp"
 #include "Text2.hpp"
 #include "ProcessesBase.hpp"
+#include "TopK.hpp"
+#include "Cgroups.hpp"
+#include "MemDetail.hpp"
 
 enum class TreeType {
     ARC = 'a',  // see also Processes::fromString
     BLOCK = 'b',
-    LINE = 'l'
+    LINE = 'l',
+    CGROUP = 'c'    // the cgroup hierarchy instead of the processes
 };
 
 // This is the virual part of Processes
@@ -44,16 +48,39 @@ public:
     virtual ~Processes();
 
     void resetProc();
+    // read the processes (and cgroups), on the sampler thread
+    void sample() override;
+    // apply the sample and set the loads, on the gui thread
     void update(std::shared_ptr<Monitor> cpu, std::shared_ptr<Monitor> mem);
-    static constexpr auto TOP_PROC = 3u;
-    void findMax(std::array<pProcess, TOP_PROC>& topMem
-               , std::array<pProcess, TOP_PROC>& topCpu);
-    void display(
+    static constexpr auto TOP_PROC = 3u;        // default number of top processes
+    static constexpr auto MAX_TOP_PROC = 20u;
+    // number of processes shown with the highest cpu/memory (and io if collected) usage, set before the first display
+    void setTopCount(uint32_t topCount);
+    // the io history is only kept while collected
+    void setCollectIo(bool collectIo) override;
+    uint32_t getTopCount() const
+    {
+        return m_topCount;
+    }
+    static constexpr auto DEFAULT_MEM_DETAIL_INTERVAL{5u};
+    // read the pss/uss/swap of the top memory processes every interval update
+    //   (in the background see MemDetailCollector), 0 disables
+    void setMemDetailInterval(uint32_t interval);
+    uint32_t getMemDetailInterval() const
+    {
+        return m_memDetailInterval;
+    }
+    void findMax(std::vector<pProcess>& topMem
+               , std::vector<pProcess>& topCpu
+               , std::vector<pProcess>& topIo);
+    // create the geometry of the tops and the tree, on the gui thread after the update
+    void updateGeometry(
             GraphShaderContext *pGraph_shaderContext,
             TextContext *_txtCtx,
             const psc::gl::ptrFont2& pFont,
             std::shared_ptr<DiagramMonitor> cpu,
             std::shared_ptr<DiagramMonitor> mem,
+            std::shared_ptr<DiagramMonitor> disk,
             Matrix &persView);
     void setTreeType(const Glib::ustring &uProcessType);
     void restore();
@@ -66,23 +93,49 @@ public:
         if (str == "l") {
             return TreeType::LINE;
         }
+        if (str == "c") {
+            return TreeType::CGROUP;
+        }
         return TreeType::ARC;       // use some default
     }
     void printInfo();
+    // only draws the geometry, so this may be used while sampling
     void displayTops(NaviContext* context, const Matrix &projView);
 protected:
     void updateCpu(GraphShaderContext *pGraph_shaderContext, TextContext *_txtCtx, const psc::gl::ptrFont2& pFont, std::shared_ptr<DiagramMonitor> cpu, Matrix &persView, Position &p);
-    void updateMem(GraphShaderContext *pGraph_shaderContext, TextContext *_txtCtx, const psc::gl::ptrFont2& pFont, std::shared_ptr<DiagramMonitor> mem, Matrix &persView, Position &p);
+    // the process history follows the cadence of cpu
+    void updateMem(GraphShaderContext *pGraph_shaderContext, TextContext *_txtCtx, const psc::gl::ptrFont2& pFont, std::shared_ptr<DiagramMonitor> mem, const DiagramMonitor& cpu, Matrix &persView, Position &p);
+    void updateIo(GraphShaderContext *pGraph_shaderContext, TextContext *_txtCtx, const psc::gl::ptrFont2& pFont, std::shared_ptr<DiagramMonitor> disk, const DiagramMonitor& cpu, Matrix &persView, Position &p);
     pProcess createProcess(std::string path, long pid) override;
+    void updateMemDetail();
 
 private:
-    std::array<pProcess, TOP_PROC> m_topMem;    // proc highest mem usage
-    std::array<pProcess, TOP_PROC> m_topCpu;  // proc highest cpu usage
-    std::array<psc::gl::aptrGeom2, TOP_PROC> m_memGeo;
-    std::array<psc::gl::aptrGeom2, TOP_PROC> m_cpuGeo;
-    std::array<psc::gl::aptrText2, TOP_PROC> m_textCpu;
-    std::array<psc::gl::aptrText2, TOP_PROC> m_textMem;
+    std::vector<pProcess> m_topMem;    // proc highest mem usage
+    std::vector<pProcess> m_topCpu;  // proc highest cpu usage
+    std::vector<pProcess> m_topIo;   // proc highest io (if collected)
+    std::vector<psc::gl::aptrGeom2> m_memGeo;
+    std::vector<psc::gl::aptrGeom2> m_cpuGeo;
+    std::vector<psc::gl::aptrGeom2> m_ioGeo;
+    std::vector<psc::gl::aptrText2> m_textCpu;
+    std::vector<psc::gl::aptrText2> m_textMem;
+    std::vector<psc::gl::aptrText2> m_textIo;
+    std::vector<Gdk::RGBA> m_cpuColors;     // for the tops, set with the count
+    std::vector<Gdk::RGBA> m_memColors;
+    std::vector<Gdk::RGBA> m_ioColors;
+    TopK<long, const pProcess*> m_selectMem;     // reused for each update
+    TopK<unsigned long, const pProcess*> m_selectCpu;
+    TopK<double, const pProcess*> m_selectIo;
     psc::gl::aptrGeom2 createBox(GeometryContext *shaderContext, Gdk::RGBA &color);
+    Gdk::RGBA topColor(const Gdk::RGBA& first, const Gdk::RGBA& last, uint32_t i);
+    uint32_t m_topCount;
     guint m_size;
+    pProcessHistory m_history;
+    std::unique_ptr<CgroupCollector> m_cgroups;     // only while displayed
+    std::unique_ptr<MemDetailCollector> m_memDetail;
+    uint32_t m_memDetailInterval;
+    uint32_t m_memDetailTicks;
+    std::vector<pid_t> m_memDetailPids;         // reused for each request
+    std::vector<MemDetail> m_memDetails;
     TreeType m_treeType;
+    bool m_dataChanged;     // updated since the tree geometry was created
 };
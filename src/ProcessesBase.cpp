@@ -23,16 +23,30 @@
 #include <fstream>
 #include <filesystem>
 #include <sys/types.h>
-#include <dirent.h>
+#include <sys/resource.h>
 #include <stdlib.h>
 #include <stdio.h>
 #include <vector>
+#include <algorithm>
 #include <Log.hpp>
 
 
 #include "ProcessesBase.hpp"
 
-ProcessesBase::ProcessesBase()
+ProcessesBase::ProcessesBase(const std::string& procDir)
+: m_procDir{procDir}
+, m_fullScanInterval{DEFAULT_FULL_SCAN_INTERVAL}
+, m_eventUpdates{0u}
+, m_lifecycle{std::make_shared<LifecycleLog>()}
+, m_snapshotSubscribers{0u}
+, m_snapshotSerial{0u}
+, m_listed{false}
+, m_sampled{false}
+, m_treeChanged{true}
+, m_collectIo{false}
+, m_idleCadence{0u}
+, m_maxOpenFiles{0u}
+, m_openFiles{0u}
 {
 }
 
@@ -44,97 +58,438 @@ ProcessesBase::~ProcessesBase()
 pProcess
 ProcessesBase::findPid(long pid)
 {
-    pProcess process;
-    auto entry = mProcesses.find(pid);
-    if (entry != mProcesses.end()) {
-        process = entry->second;
+    auto proc = mProcesses.find(pid);
+    return proc ? *proc : pProcess{};
+}
+
+void
+ProcessesBase::setScanThreads(uint32_t scanThreads)
+{
+    scanThreads = std::clamp(scanThreads, DEFAULT_SCAN_THREADS, MAX_SCAN_THREADS);
+    if (scanThreads != getScanThreads()) {
+        m_scanPool.reset();
+        if (scanThreads > 1u) {
+            m_scanPool = std::make_unique<ScanPool>(scanThreads);
+        }
+    }
+}
+
+uint32_t
+ProcessesBase::getScanThreads() const
+{
+    return m_scanPool ? m_scanPool->getThreads() : DEFAULT_SCAN_THREADS;
+}
+
+void
+ProcessesBase::setMaxOpenFiles(uint32_t maxOpenFiles)
+{
+    struct rlimit limit;
+    if (maxOpenFiles > 0u
+     && getrlimit(RLIMIT_NOFILE, &limit) == 0
+     && limit.rlim_cur != RLIM_INFINITY) {
+        rlim_t avail = limit.rlim_cur > RESERVED_FILES ? limit.rlim_cur - RESERVED_FILES : 0u;
+        if (maxOpenFiles > avail) {
+            psc::log::Log::logAdd(psc::log::Level::Notice, [&] {
+                return psc::fmt::format("Limiting open process files {} to {} by rlimit", maxOpenFiles, avail);
+            });
+            maxOpenFiles = static_cast<uint32_t>(avail);
+        }
+    }
+    m_maxOpenFiles = maxOpenFiles;
+    for (auto& proc : mProcesses) {   // apply to running as well, as changing might close
+        if (proc->isKeepOpen()
+         && m_openFiles > m_maxOpenFiles) {
+            proc->setKeepOpen(false);
+            m_openFiles -= FILES_PER_PROCESS;
+        }
     }
-    return process;
+}
+
+void
+ProcessesBase::setCollectIo(bool collectIo)
+{
+    m_collectIo = collectIo;
+    for (auto& proc : mProcesses) {
+        proc->setCollectIo(m_collectIo);
+    }
+}
+
+void
+ProcessesBase::setIdleCadence(uint32_t idleCadence)
+{
+    m_idleCadence = idleCadence;
+    for (auto& proc : mProcesses) {
+        proc->setIdleCadence(m_idleCadence);
+    }
+}
+
+// decide if we can keep the files open, everything above the limit is opened by each update
+void
+ProcessesBase::added(const pProcess& proc)
+{
+    if (m_openFiles + FILES_PER_PROCESS <= m_maxOpenFiles) {
+        proc->setKeepOpen(true);
+        m_openFiles += FILES_PER_PROCESS;
+    }
+    if (m_listed) {
+        LifecycleEvent event{LifecycleEvent::Type::Spawn
+                           , static_cast<pid_t>(proc->getPid())
+                           , static_cast<pid_t>(proc->getPpid())
+                           , {}
+                           , LifecycleLog::nowMs()
+                           , 0};
+        event.setName(proc->getInternedName());
+        m_lifecycle->add(event);
+    }
+}
+
+void
+ProcessesBase::exited(const pProcess& proc)
+{
+    LifecycleEvent event{LifecycleEvent::Type::Exit
+                       , static_cast<pid_t>(proc->getPid())
+                       , static_cast<pid_t>(proc->getPpid())
+                       , {}
+                       , LifecycleLog::nowMs()
+                       , LifecycleLog::lifetimeMs(proc->getStartTime())};
+    event.setName(proc->getInternedName());
+    m_lifecycle->add(event);
+}
+
+pProcess
+ProcessesBase::create(long pid, ProcReader& reader)
+{
+    auto path = Glib::ustring::sprintf("%s/%ld", m_procDir.c_str(), pid);
+    auto proc = createProcess(path, pid);
+    proc->setCollectIo(m_collectIo);
+    proc->setIdleCadence(m_idleCadence);
+    proc->update(reader);
+    if (m_filter) {
+        proc->setFilterMatch(m_filter->matches(*proc));
+    }
+    return proc;
+}
+
+// read the process infos, with a pool the known and new processes are split into shards,
+//   each thread works only with its own processes, new processes are
+//   collected by shard and merged afterwards on the calling thread,
+//   same for the processes that changed their parent
+void
+ProcessesBase::scan()
+{
+    size_t known = m_scanKnown.size();
+    size_t count = known + m_scanNew.size();
+    if (m_scanPool
+     && count >= MIN_SHARD_SIZE * m_scanPool->getThreads()) {
+        m_scanCreated.resize(m_scanPool->getThreads());
+        m_scanRelink.resize(m_scanPool->getThreads());
+        m_scanPool->run(count,
+            [this, known] (size_t begin, size_t end, ProcReader& reader, uint32_t shard) {
+            auto& created = m_scanCreated[shard];
+            auto& relink = m_scanRelink[shard];
+            for (size_t i = begin; i < end; ++i) {
+                if (i < known) {
+                    auto& proc = m_scanKnown[i];
+                    proc->update(reader);
+                    if (m_filter) {
+                        proc->setFilterMatch(m_filter->matches(*proc));
+                    }
+                    if (proc->isParentChanged()) {
+                        relink.push_back(proc);
+                    }
+                }
+                else {
+                    created.push_back(create(m_scanNew[i - known], reader));
+                }
+            }
+        });
+        for (auto& created : m_scanCreated) {
+            for (auto& proc : created) {
+                mProcesses.insert(proc->getPid(), proc);
+                added(proc);
+                m_relink.push_back(proc);
+            }
+            created.clear();
+        }
+        for (auto& relink : m_scanRelink) {
+            m_relink.insert(m_relink.end(), relink.begin(), relink.end());
+            relink.clear();
+        }
+    }
+    else {
+        for (auto& proc : m_scanKnown) {
+            proc->update(m_reader);
+            if (m_filter) {
+                proc->setFilterMatch(m_filter->matches(*proc));
+            }
+            if (proc->isParentChanged()) {
+                m_relink.push_back(proc);
+            }
+        }
+        for (auto pid : m_scanNew) {
+            auto proc = create(pid, m_reader);
+            mProcesses.insert(pid, proc);
+            added(proc);
+            m_relink.push_back(proc);
+        }
+    }
+    m_scanKnown.clear();
+    m_scanNew.clear();
+}
+
+void
+ProcessesBase::setProcEvents(std::unique_ptr<ProcEventSource> events, uint32_t fullScanInterval)
+{
+    if (events && !events->isConnected()) {
+        psc::log::Log::logAdd(psc::log::Level::Notice, "No process events (requires CAP_NET_ADMIN), using the scan of /proc");
+        events.reset();
+    }
+    m_procEvents = std::move(events);
+    m_fullScanInterval = std::max(fullScanInterval, 1u);
+    m_eventUpdates = 0u;
+}
+
+// with events the pids are the known processes that did not exit plus the forked ones,
+//   the directory is listed every fullScanInterval updates or if events were lost
+bool
+ProcessesBase::listPids()
+{
+    if (m_procEvents) {
+        m_events.clear();
+        bool complete = m_procEvents->read(m_events);
+        bool full = !complete || m_eventUpdates % m_fullScanInterval == 0u;
+        ++m_eventUpdates;
+        if (!full) {
+            m_pids.clear();
+            m_exited.clear();
+            for (auto& event : m_events) {
+                if (event.type == ProcEvent::Type::Exit) {
+                    m_exited.push_back(event.pid);
+                }
+            }
+            // a pid reused in one interval is missed, until the next full scan
+            std::sort(m_exited.begin(), m_exited.end());
+            for (auto& event : m_events) {
+                if (event.type == ProcEvent::Type::Fork
+                 && !mProcesses.contains(event.pid)
+                 && !std::binary_search(m_exited.begin(), m_exited.end(), event.pid)) {
+                    m_pids.push_back(event.pid);
+                }
+            }
+            for (auto& proc : mProcesses) {     // the closing ones are gone already
+                pid_t pid = static_cast<pid_t>(proc->getPid());
+                if (proc->getStage() < psc::gl::TreeNodeState::Close
+                 && !std::binary_search(m_exited.begin(), m_exited.end(), pid)) {
+                    m_pids.push_back(pid);
+                }
+            }
+            return true;
+        }
+    }
+    return m_pidScanner.scan(m_procDir.c_str(), m_pids);
 }
 
 void
 ProcessesBase::update()
 {
-    DIR *dir;
-    struct dirent *ent;
-    if ((dir = opendir(sdir)) != nullptr) {
+    sample();
+    present();
+}
+
+void
+ProcessesBase::sample()
+{
+    std::lock_guard<std::mutex> lock(m_sampleMutex);
+    m_sampled = listPids();
+    if (m_sampled) {
         /* find all the processes in /proc */
-        for (auto& p : mProcesses) {
-            auto& proc = p.second;
+        for (auto& proc : mProcesses) {
             if (proc->isActive()) {
                 proc->setStage(psc::gl::TreeNodeState::Running);
+                if (proc->isKeepOpen()) {   // these tell us by reading if they are gone
+                    m_scanKnown.push_back(proc);
+                }
             }
             proc->setTouched(false);
         }
-        while ((ent = readdir(dir)) != nullptr) {
-            if (ent->d_type == DT_DIR) {
-                long pid = std::atol(ent->d_name);
-                if (pid > 0) {
-                    auto p = mProcesses.find(pid);
-                    pProcess proc;
-                    if (p != mProcesses.end()) {
-                        proc = p->second;
-                    }
-                    else {
-                        auto path = Glib::ustring::sprintf("%s/%ld", sdir, pid);
-                        proc = createProcess(path, pid);
-                        mProcesses.insert(std::pair(pid, proc));
-                    }
-                    proc->update();
+        for (auto pid : m_pids) {
+            auto known = mProcesses.find(pid);
+            if (known) {
+                auto& proc = *known;
+                if (!proc->isKeepOpen() || !proc->isActive()) {
+                    m_scanKnown.push_back(proc);
                 }
             }
+            else {
+                m_scanNew.push_back(pid);
+            }
         }
-        closedir(dir);
-        for (auto p = mProcesses.begin(); p != mProcesses.end(); ) {
-            auto& proc = p->second;
+        scan();
+    }
+}
+
+void
+ProcessesBase::present()
+{
+    if (m_sampled) {
+        m_sampled = false;
+        linkTree();     // before erasing, so no removed process gets linked again
+        mProcesses.eraseIf([this] (const pProcess& proc) {
             if (!proc->isTouched()) {   // if we didn't touch the entry process died
                 if (proc->getStage() < psc::gl::TreeNodeState::Close) {    // close in 2 steps to show status
                     proc->setStage(psc::gl::TreeNodeState::Close);
-                    ++p;
+                    exited(proc);
                 }
                 else {
                     auto parent = proc->getParent();
                     if (parent) {   // remove any reference
                         parent->remove(proc.get());
+                        m_treeChanged = true;
+                    }
+                    if (proc->isKeepOpen()) {
+                        proc->setKeepOpen(false);
+                        m_openFiles -= FILES_PER_PROCESS;
                     }
-                    p = mProcesses.erase(p);    // make unreachable, the inc needs to be post increment (the doc says it is incremented internally this might be right in the case of a vector) !!!
+                    return true;    // make unreachable
                 }
             }
-            else {
-                ++p;
+            return false;
+        });
+        m_listed = true;
+        if (m_filter) {
+            markShown();
+        }
+    }
+    findRoot();
+}
+
+void
+ProcessesBase::setFilter(std::shared_ptr<const ProcessFilter> filter)
+{
+    m_filter = filter;
+    for (auto& proc : mProcesses) {
+        if (m_filter) {
+            proc->setFilterMatch(m_filter->matches(*proc));
+        }
+        else {
+            proc->setShown(true);
+        }
+    }
+    if (m_filter) {
+        markShown();
+    }
+}
+
+void
+ProcessesBase::subscribeSnapshot()
+{
+    ++m_snapshotSubscribers;
+    std::unique_lock<std::mutex> sampling(m_sampleMutex, std::try_to_lock);
+    if (sampling.owns_lock()
+     && !getSnapshot()) {
+        publishSnapshot();
+    }
+}
+
+void
+ProcessesBase::unsubscribeSnapshot()
+{
+    if (m_snapshotSubscribers > 0u
+     && --m_snapshotSubscribers == 0u) {
+        std::lock_guard<std::mutex> lock(m_snapshotMutex);
+        m_snapshot.reset();     // the consumers may keep theirs
+    }
+}
+
+void
+ProcessesBase::publishSnapshot()
+{
+    if (m_snapshotSubscribers == 0u) {
+        return;
+    }
+    auto snapshot = std::make_shared<ProcessSnapshot>(++m_snapshotSerial, mProcesses.size());
+    for (auto& proc : mProcesses) {
+        snapshot->add(*proc);
+    }
+    snapshot->link();
+    std::lock_guard<std::mutex> lock(m_snapshotMutex);
+    m_snapshot = std::move(snapshot);
+}
+
+std::shared_ptr<const ProcessSnapshot>
+ProcessesBase::getSnapshot() const
+{
+    std::lock_guard<std::mutex> lock(m_snapshotMutex);
+    return m_snapshot;
+}
+
+// show the matching processes with their ancestors,
+//   the walk up stops at the first ancestor that is shown already
+void
+ProcessesBase::markShown()
+{
+    for (auto& proc : mProcesses) {
+        proc->setShown(false);
+    }
+    for (auto& proc : mProcesses) {
+        if (proc->isFilterMatch()
+         && proc->isActive()) {
+            Process* shown = proc.get();
+            while (shown && !shown->isShown()) {
+                shown->setShown(true);
+                auto parent = shown->getParent();
+                shown = parent ? dynamic_cast<Process*>(&*parent) : nullptr;
             }
         }
     }
-    buildTree();
 }
 
 pProcess
 ProcessesBase::createProcess(std::string path, long pid)
 {
-    return std::make_shared<Process>(path, pid, 0);
+    return std::make_shared<Process>(path, pid);
 }
 
+// link all processes, usually only the changed ones need this see linkTree
 void
 ProcessesBase::buildTree()
 {
-    for (auto& p : mProcesses) {
-        auto& proc = p.second;      // as process assignments might change rebuild tree
+    for (auto& proc : mProcesses) {
+        m_relink.push_back(proc);
+    }
+    linkTree();
+    findRoot();
+}
 
+// the parent only changes for new processes or if the parent exits (reparent to init/subreaper)
+void
+ProcessesBase::linkTree()
+{
+    for (auto& proc : m_relink) {
         long ppid = proc->getPpid();
-        auto pp = mProcesses.find(ppid);
-        if (pp != mProcesses.end()) {
-            pProcess pproc = pp->second;
-            proc->setParent(pproc.get(), proc);
+        auto pproc = mProcesses.find(ppid);
+        if (pproc) {
+            proc->setParent(pproc->get(), proc);
         }
         else {
             // some kernel internal porcess have ppid 0 dont expect much impact by them ?
             //std::cout << "Process " << ppid << " not founnd!" << std::endl;
         }
+        proc->setLinked();
     }
+    if (!m_relink.empty()) {
+        m_treeChanged = true;
+        m_relink.clear();
+    }
+}
+
+void
+ProcessesBase::findRoot()
+{
     if (!m_procRoot) {
         auto pr = mProcesses.find(ROOT_PID);  // seems as we can be sure proc 1 is the root
-        if (pr != mProcesses.end()) {
-            m_procRoot = pr->second;
+        if (pr) {
+            m_procRoot = *pr;
         }
         else {
             // as update and redraw happen asynchronously this will happen on first call
@@ -142,4 +497,3 @@ ProcessesBase::buildTree()
         }
     }
 }
-
@@ -18,30 +18,143 @@
 
 #pragma once
 
-#include <map>
 #include <iostream>
 #include <memory>
+#include <vector>
+#include <mutex>
 
 #include "Process.hpp"
+#include "ProcReader.hpp"
+#include "ScanPool.hpp"
+#include "PidScanner.hpp"
+#include "PidMap.hpp"
+#include "ProcEvents.hpp"
+#include "Lifecycle.hpp"
+#include "ProcessFilter.hpp"
+#include "ProcessSnapshot.hpp"
 
 static const long ROOT_PID = 1l;
 
+using ProcessMap = PidMap<pProcess>;
+
 class ProcessesBase
 {
 public:
-    ProcessesBase();
+    // the dir is only changed for testing
+    ProcessesBase(const std::string& procDir = sdir);
     virtual ~ProcessesBase();
 
+    // sample then present on the calling thread
     void update();
+    // list and read the processes (new ones are created), this may block on /proc
+    //   so it is done by the sampler thread, the processes are not to be used meanwhile
+    virtual void sample();
+    // link the tree and remove the exited processes, on the gui thread after the sample
+    void present();
     void buildTree();
+    // set if processes where linked or removed since the flag was reset
+    bool isTreeChanged() const
+    {
+        return m_treeChanged;
+    }
+    void setTreeChanged(bool treeChanged)
+    {
+        m_treeChanged = treeChanged;
+    }
     pProcess findPid(long pid);
-protected:
-    std::map<long, pProcess> mProcesses;
+    // number of threads used to read process infos, 1 reads on the calling thread
+    void setScanThreads(uint32_t scanThreads);
+    uint32_t getScanThreads() const;
+    static constexpr auto DEFAULT_SCAN_THREADS{1u};
+    static constexpr auto MAX_SCAN_THREADS{64u};
+    // keep up to this number of files open to save open/close on each update, 0 disables
+    void setMaxOpenFiles(uint32_t maxOpenFiles);
+    uint32_t getMaxOpenFiles() const
+    {
+        return m_maxOpenFiles;
+    }
+    // use process events to find new and exited processes, /proc is listed every fullScanInterval updates,
+    //   a source that is not connected is ignored, nullptr lists /proc on each update
+    void setProcEvents(std::unique_ptr<ProcEventSource> events, uint32_t fullScanInterval = DEFAULT_FULL_SCAN_INTERVAL);
+    static constexpr auto DEFAULT_FULL_SCAN_INTERVAL{10u};
+    // read /proc/[pid]/io on update, only the processes of the user are readable (without CAP_SYS_PTRACE)
+    virtual void setCollectIo(bool collectIo);
+    bool isCollectIo() const
+    {
+        return m_collectIo;
+    }
+    // read the status of idle processes only every idleCadence update (see Process::setIdleCadence)
+    void setIdleCadence(uint32_t idleCadence);
+    uint32_t getIdleCadence() const
+    {
+        return m_idleCadence;
+    }
+    static constexpr auto DEFAULT_IDLE_CADENCE{8u};
+    // evaluate the filter on the scan, only the matching processes
+    //   and their ancestors are shown (see Process::isShown), nullptr shows all
+    void setFilter(std::shared_ptr<const ProcessFilter> filter);
+    // while there are subscribers publishSnapshot creates a snapshot of the processes,
+    //   the first subscriber gets one immediately unless a sample is running,
+    //   then with the next present (call these on the gui thread)
+    void subscribeSnapshot();
+    void unsubscribeSnapshot();
+    // call after the update (and anything that adds to the processes e.g. the load)
+    void publishSnapshot();
+    // the latest published, nullptr without subscribers, may be used from any thread
+    std::shared_ptr<const ProcessSnapshot> getSnapshot() const;
+    // the spawned and exited processes, the processes found by the first update are not logged
+    std::shared_ptr<LifecycleLog> getLifecycle() const
+    {
+        return m_lifecycle;
+    }
     constexpr static auto sdir = "/proc";
+protected:
+    ProcessMap mProcesses;
     virtual pProcess createProcess(std::string path, long pid);
     pProcess m_procRoot;
 
 private:
+    bool listPids();
+    void scan();
+    pProcess create(long pid, ProcReader& reader);
+    void added(const pProcess& proc);
+    void exited(const pProcess& proc);
+    void markShown();
+    void linkTree();
+    void findRoot();
+
+    std::string m_procDir;
+    ProcReader m_reader;    // reuse buffer for all processes
+    PidScanner m_pidScanner;
+    std::vector<pid_t> m_pids;  // reused for each update
+    std::unique_ptr<ProcEventSource> m_procEvents;
+    std::vector<ProcEvent> m_events;
+    std::vector<pid_t> m_exited;
+    uint32_t m_fullScanInterval;
+    uint32_t m_eventUpdates;
+    std::unique_ptr<ScanPool> m_scanPool;
+    std::vector<pProcess> m_scanKnown;
+    std::vector<long> m_scanNew;
+    std::vector<std::vector<pProcess>> m_scanCreated;  // results by shard
+    std::vector<std::vector<pProcess>> m_scanRelink;   // by shard as well
+    std::vector<pProcess> m_relink;    // processes with a new/changed parent
+    std::shared_ptr<LifecycleLog> m_lifecycle;
+    std::shared_ptr<const ProcessFilter> m_filter;
+    uint32_t m_snapshotSubscribers;
+    uint64_t m_snapshotSerial;
+    mutable std::mutex m_snapshotMutex;     // only held to swap the pointer
+    std::mutex m_sampleMutex;       // held while sampling, a snapshot on subscribe is skipped meanwhile
+    std::shared_ptr<const ProcessSnapshot> m_snapshot;
+    bool m_listed;          // the first update is done
+    bool m_sampled;         // the processes were listed by sample, present has to merge
+    bool m_treeChanged;
+    bool m_collectIo;
+    uint32_t m_idleCadence;
+    static constexpr auto MIN_SHARD_SIZE{32u};     // below this a thread is not worth the effort
+    uint32_t m_maxOpenFiles;
+    uint32_t m_openFiles;
+    static constexpr auto FILES_PER_PROCESS{2u};   // stat, status
+    static constexpr auto RESERVED_FILES{256u};    // leave some files for everyone else
 
 };
 
@@ -0,0 +1,113 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "Sampler.hpp"
+
+Sampler::Sampler(const std::function<void()>& collect, const std::function<void()>& done)
+: m_collect{collect}
+, m_done{done}
+, m_pending{false}
+, m_ready{false}
+, m_stop{false}
+, m_thread{&Sampler::worker, this}
+{
+}
+
+Sampler::~Sampler()
+{
+    stop();
+}
+
+bool
+Sampler::request()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    if (m_stop
+     || m_pending
+     || m_ready) {
+        return false;
+    }
+    m_pending = true;
+    lock.unlock();
+    m_start.notify_one();
+    return true;
+}
+
+bool
+Sampler::take()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    bool ready = m_ready;
+    m_ready = false;
+    return ready;
+}
+
+bool
+Sampler::isBusy()
+{
+    std::lock_guard<std::mutex> lock(m_mutex);
+    return m_pending;
+}
+
+void
+Sampler::wait()
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_finished.wait(lock, [this] {
+        return !m_pending;
+    });
+}
+
+void
+Sampler::stop()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_start.notify_one();
+    if (m_thread.joinable()) {
+        m_thread.join();    // waits for a running sample
+    }
+}
+
+void
+Sampler::worker()
+{
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_start.wait(lock, [this] {
+                return m_stop || m_pending;
+            });
+            if (m_stop) {
+                m_pending = false;
+                break;
+            }
+        }
+        m_collect();
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_ready = true;
+            m_pending = false;
+        }
+        m_finished.notify_all();
+        m_done();
+    }
+    m_finished.notify_all();
+}
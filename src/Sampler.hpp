@@ -0,0 +1,60 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+
+// runs the collection of the monitors on its own thread, so a slow read
+//   (e.g. statvfs of a hung nfs mount) does not block the gui.
+//   From request until the sample is taken the collectors belong to the sampler,
+//   the gui thread has to check isBusy before it reads them. As only the gui
+//   requests, a sampler that is not busy stays so until the next request.
+//   The done function is called on the sampler thread (e.g. emit a dispatcher).
+class Sampler
+{
+public:
+    Sampler(const std::function<void()>& collect, const std::function<void()>& done);
+    explicit Sampler(const Sampler& orig) = delete;
+    virtual ~Sampler();
+
+    // false if the previous sample is still collected or not taken
+    bool request();
+    // true once for each finished sample
+    bool take();
+    bool isBusy();
+    // block until the running sample is finished
+    void wait();
+    // after this no more samples are collected
+    void stop();
+private:
+    void worker();
+
+    std::function<void()> m_collect;
+    std::function<void()> m_done;
+    std::mutex m_mutex;
+    std::condition_variable m_start;
+    std::condition_variable m_finished;
+    bool m_pending;     // requested but not finished
+    bool m_ready;       // finished but not taken
+    bool m_stop;
+    std::thread m_thread;   // last, as it uses the members above
+};
@@ -0,0 +1,91 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "ScanPool.hpp"
+
+ScanPool::ScanPool(uint32_t threads)
+: m_work{nullptr}
+, m_count{0u}
+, m_generation{0u}
+, m_pending{0u}
+, m_stop{false}
+{
+    m_threads.reserve(threads);
+    for (uint32_t shard = 0; shard < threads; ++shard) {
+        m_threads.emplace_back(&ScanPool::worker, this, shard);
+    }
+}
+
+ScanPool::~ScanPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_mutex);
+        m_stop = true;
+    }
+    m_start.notify_all();
+    for (auto& thread : m_threads) {
+        thread.join();
+    }
+}
+
+void
+ScanPool::run(size_t count, const Work& work)
+{
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_work = &work;
+    m_count = count;
+    m_pending = getThreads();
+    ++m_generation;
+    m_start.notify_all();
+    m_done.wait(lock, [this] {
+        return m_pending == 0u;
+    });
+    m_work = nullptr;
+}
+
+void
+ScanPool::worker(uint32_t shard)
+{
+    ProcReader reader;
+    uint64_t generation{0u};
+    while (true) {
+        const Work* work;
+        size_t begin, end;
+        {
+            std::unique_lock<std::mutex> lock(m_mutex);
+            m_start.wait(lock, [this, generation] {
+                return m_stop || m_generation != generation;
+            });
+            if (m_stop) {
+                break;
+            }
+            generation = m_generation;
+            work = m_work;
+            auto threads = getThreads();
+            begin = m_count * shard / threads;
+            end = m_count * (shard + 1u) / threads;
+        }
+        if (begin < end) {
+            (*work)(begin, end, reader, shard);
+        }
+        std::lock_guard<std::mutex> lock(m_mutex);
+        if (--m_pending == 0u) {
+            m_done.notify_one();
+        }
+    }
+}
@@ -0,0 +1,61 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <vector>
+#include <memory>
+
+#include "ProcReader.hpp"
+
+// a fixed set of threads that split a range of work items into shards,
+//   each thread uses its own reader (buffer).
+//   run blocks until all shards are done,
+//   so the caller may hand out work that references its own data.
+class ScanPool
+{
+public:
+    // work on the items [begin, end) with the given reader, shard identifies the thread-local results
+    using Work = std::function<void(size_t begin, size_t end, ProcReader& reader, uint32_t shard)>;
+
+    ScanPool(uint32_t threads);
+    explicit ScanPool(const ScanPool& orig) = delete;
+    virtual ~ScanPool();
+
+    void run(size_t count, const Work& work);
+    uint32_t getThreads() const
+    {
+        return static_cast<uint32_t>(m_threads.size());
+    }
+private:
+    void worker(uint32_t shard);
+
+    std::vector<std::thread> m_threads;
+    std::mutex m_mutex;
+    std::condition_variable m_start;
+    std::condition_variable m_done;
+    const Work* m_work;
+    size_t m_count;
+    uint64_t m_generation;
+    uint32_t m_pending;
+    bool m_stop;
+};
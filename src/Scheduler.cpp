@@ -0,0 +1,96 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <cerrno>
+
+#include "Scheduler.hpp"
+
+Scheduler::Scheduler()
+: m_fd{-1}
+, m_periodMs{0u}
+, m_tick{0u}
+, m_previousTick{0u}
+, m_marked{false}
+{
+}
+
+Scheduler::~Scheduler()
+{
+    if (m_fd >= 0) {
+        close(m_fd);
+    }
+}
+
+bool
+Scheduler::start(uint32_t periodMs)
+{
+    if (m_fd < 0) {
+        m_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+        if (m_fd < 0) {
+            return false;
+        }
+    }
+    m_periodMs = periodMs > 0u ? periodMs : 1u;
+    struct itimerspec spec{};
+    spec.it_interval.tv_sec = m_periodMs / 1000u;
+    spec.it_interval.tv_nsec = static_cast<long>(m_periodMs % 1000u) * 1000000l;
+    spec.it_value = spec.it_interval;   // relative to now, the following are on the grid of the first
+    return timerfd_settime(m_fd, 0, &spec, nullptr) == 0;
+}
+
+void
+Scheduler::stop()
+{
+    if (m_fd >= 0) {
+        struct itimerspec spec{};
+        timerfd_settime(m_fd, 0, &spec, nullptr);
+    }
+}
+
+uint64_t
+Scheduler::expired()
+{
+    uint64_t count{};
+    if (m_fd < 0
+     || read(m_fd, &count, sizeof(count)) != static_cast<ssize_t>(sizeof(count))) {
+        return 0u;      // EAGAIN without expiration
+    }
+    m_tick += count;
+    return count;
+}
+
+void
+Scheduler::mark()
+{
+    m_previousTick = m_tick;
+    m_marked = true;
+}
+
+bool
+Scheduler::isDue(uint32_t ticks) const
+{
+    if (!m_marked) {
+        return true;
+    }
+    if (ticks <= 1u) {
+        return m_tick != m_previousTick;
+    }
+    return m_tick / ticks != m_previousTick / ticks;
+}
@@ -0,0 +1,62 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <cstdint>
+
+// periodic ticks from a timerfd on the monotonic clock, the kernel counts
+//   the expirations, so the period does not drift with the time the handling
+//   takes, and late ticks are counted instead of shifting the following.
+//   The fd is meant to be watched by the main loop (readable on expiration).
+//   The rates are given as ticks, e.g. 4 is due on every 4th tick.
+class Scheduler
+{
+public:
+    Scheduler();
+    explicit Scheduler(const Scheduler& orig) = delete;
+    virtual ~Scheduler();
+
+    // (re-)start with the period, false if the timer is not available
+    bool start(uint32_t periodMs);
+    void stop();
+    int getFd() const
+    {
+        return m_fd;
+    }
+    uint32_t getPeriodMs() const
+    {
+        return m_periodMs;
+    }
+    // read the expirations, returns the number since the last call (0 if none)
+    uint64_t expired();
+    uint64_t getTick() const
+    {
+        return m_tick;
+    }
+    // true if the rate passed a multiple since the last mark (all are due before the first)
+    bool isDue(uint32_t ticks) const;
+    // the dues were handled up to the actual tick, a skipped tick stays due until the next mark
+    void mark();
+private:
+    int m_fd;
+    uint32_t m_periodMs;
+    uint64_t m_tick;
+    uint64_t m_previousTick;
+    bool m_marked;
+};
@@ -28,6 +28,7 @@
 
 #include "monglmm_config.h"
 #include "TempMonitor.hpp"
+#include "MonglView.hpp"
 #ifdef LMSENSORS
 #include "LmSensor.hpp"
 #include "LmSensors.hpp"
@@ -76,29 +77,31 @@ Gtk::Box *
 TempMonitor::create_config_page(MonglView *monglView)
 {
     auto hw_box = create_config_page(
-            _("Temperature"));
+            _("Temperature"), monglView);
     return hw_box;
 }
 
 void
-TempMonitor::sensor_changed(guint index, Gtk::ComboBox *combo)
+TempMonitor::sensor_changed(guint index, Gtk::ComboBox *combo, MonglView *monglView)
 {
     Glib::ustring name = combo->get_active_id();
-    while (index >= m_actSensors.size()) {
-        m_actSensors.push_back(nullptr);
-    }
-    if (!name.empty()) {
-        for (auto sensors : m_allSensors) {
-            auto sensor = sensors->getSensor(name);
-            if (sensor) {
-                m_actSensors[index] = sensor;
-                break;
+    monglView->changeCollectors([this, index, name] {
+        while (index >= m_actSensors.size()) {
+            m_actSensors.push_back(nullptr);
+        }
+        if (!name.empty()) {
+            for (auto sensors : m_allSensors) {
+                auto sensor = sensors->getSensor(name);
+                if (sensor) {
+                    m_actSensors[index] = sensor;
+                    break;
+                }
             }
         }
-    }
-    else {
-        m_actSensors[index] = nullptr;        // clear reference
-    }
+        else {
+            m_actSensors[index] = nullptr;        // clear reference
+        }
+    });
 }
 
 void
@@ -108,7 +111,7 @@ TempMonitor::color_changed(guint index, Gtk::ColorButton *color_button)
 }
 
 void
-TempMonitor::createEntry(Gtk::Box *box, guint index)
+TempMonitor::createEntry(Gtk::Box *box, guint index, MonglView *monglView)
 {
     auto color_button = Gtk::manage(new Gtk::ColorButton());
     color_button->set_rgba(m_colors[index]);
@@ -139,9 +142,9 @@ TempMonitor::createEntry(Gtk::Box *box, guint index)
         combo->set_active_id("");
     }
     combo->signal_changed().connect(
-                    sigc::bind<guint, Gtk::ComboBox *>(
+                    sigc::bind<guint, Gtk::ComboBox *, MonglView *>(
                     sigc::mem_fun(*this, &TempMonitor::sensor_changed),
-                    index, combo));
+                    index, combo, monglView));
     hbox1->pack_start(*combo, TRUE, TRUE, 0);
     char temp[64];
     snprintf(temp, sizeof(temp), "%s %d", CONFIG_DISPLAY_TEMP, index);
@@ -159,11 +162,11 @@ TempMonitor::getColor(unsigned int diagram)
 }
 
 Gtk::Box *
-TempMonitor::create_config_page(const char *enabledLabel)
+TempMonitor::create_config_page(const char *enabledLabel, MonglView *monglView)
 {
     auto box = Gtk::manage(new Gtk::Box(Gtk::Orientation::ORIENTATION_VERTICAL, 0));
     for (guint i = 0; i < m_colors.size(); ++i) {
-        createEntry(box, i);
+        createEntry(box, i, monglView);
     }
 
     return box;
@@ -194,32 +197,17 @@ TempMonitor::close()
 
 
 void
-TempMonitor::updateG15(Cairo::RefPtr<Cairo::Context> cr, guint width, guint height)
+TempMonitor::fillG15(G15Frame& frame)
 {
     int i = 0;
     for (auto s : m_actSensors) {
         if (s) {
-    // might help to keep text adjusted further down the line
-    //cairo_font_extents_t fe;
-    //cairo_text_extents_t te;
-    //char alphabet[] = "AbCdEfGhIjKlMnOpQrStUvWxYz";
-    //char letter[2];
-    //
-    //cairo_font_extents (cr, &fe);
-    //for (i=0; i < strlen(alphabet); i++) {
-    //    *letter = '\0';
-    //    strncat (letter, alphabet + i, 1);
-    //cairo_text_extents (cr, letter, &te);
-    //cairo_move_to (cr, i + 0.5 - te.x_bearing - te.width / 2,
-    //        0.5 - fe.descent + fe.height / 2);
-    //cairo_show_text (cr, letter);
-
-            cr->move_to(0.5, (i+1)*10.0);
+            double value = getValues(i)->get(m_size-1) * s->getMax();    // as read by update
             std::ostringstream oss ;
             oss << formatScale(s->getMin(), s->getUnit().c_str(), 1000.0)
-                << "< " << formatScale(s->read(), s->getUnit().c_str(), 1000.0)
+                << "< " << formatScale(value, s->getUnit().c_str(), 1000.0)
                 << " <" << formatScale(s->getMax(), s->getUnit().c_str(), 1000.0);
-            cr->show_text(oss.str());
+            frame.lines.push_back(oss.str());
             ++i;
         }
     }
@@ -32,7 +32,11 @@ public:
     virtual ~TempMonitor();
 
     gboolean update(int refreshRate, glibtop * glibtop) override;
-    void updateG15(Cairo::RefPtr<Cairo::Context> cr, guint width, guint height) override;
+    // the sensors may sit on a slow bus (e.g. i2c) and change slowly
+    guint getPreferredPeriod() const override {
+        return 2000u;
+    }
+    void fillG15(G15Frame& frame) override;
 
     void load_settings(const Glib::KeyFile * setting) override;
 
@@ -44,12 +48,12 @@ public:
     std::string getSecMax() override;
     void close() override;
 
-    Gtk::Box *create_config_page(const char *enabledLabel);
-    void sensor_changed(guint index, Gtk::ComboBox *combo);
+    Gtk::Box *create_config_page(const char *enabledLabel, MonglView *monglView);
+    void sensor_changed(guint index, Gtk::ComboBox *combo, MonglView *monglView);
     void color_changed(guint index, Gtk::ColorButton *color);
     Gdk::RGBA *getColor(unsigned int diagram) override;
 private:
-    void createEntry(Gtk::Box *box, guint index);
+    void createEntry(Gtk::Box *box, guint index, MonglView *monglView);
     std::vector<std::shared_ptr<Sensors>> m_allSensors;
 
     std::vector<std::shared_ptr<Sensor>> m_actSensors;
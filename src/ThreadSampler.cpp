@@ -0,0 +1,182 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <unistd.h>
+#include <algorithm>
+
+#include "ThreadSampler.hpp"
+
+ThreadSampler::ThreadSampler(uint32_t slots, const std::string& procDir)
+: m_procDir{procDir}
+, m_history{std::make_shared<ProcessHistory>(slots)}
+, m_next{0u}
+, m_maxReads{DEFAULT_MAX_READS}
+, m_minIntervalUs{DEFAULT_MIN_INTERVAL_US}
+, m_lastSample{0}
+, m_clkTck{static_cast<double>(sysconf(_SC_CLK_TCK))}
+{
+}
+
+ThreadSampler::~ThreadSampler()
+{
+    clear();
+}
+
+void
+ThreadSampler::add(long pid)
+{
+    if (!isSampled(pid)) {
+        auto sampled = std::make_unique<Sampled>();
+        sampled->pid = pid;
+        sampled->taskDir = m_procDir + "/" + std::to_string(pid) + "/task";
+        m_sampled.push_back(std::move(sampled));
+        m_lastSample = 0;   // show the threads with the next sample
+    }
+}
+
+void
+ThreadSampler::remove(long pid)
+{
+    for (auto iter = m_sampled.begin(); iter != m_sampled.end(); ++iter) {
+        if ((*iter)->pid == pid) {
+            for (auto& thread : (*iter)->threads) {
+                m_history->release(thread.historyIndex);
+            }
+            m_sampled.erase(iter);
+            break;
+        }
+    }
+}
+
+void
+ThreadSampler::clear()
+{
+    while (!m_sampled.empty()) {
+        remove(m_sampled.back()->pid);
+    }
+}
+
+bool
+ThreadSampler::isSampled(long pid) const
+{
+    for (auto& sampled : m_sampled) {
+        if (sampled->pid == pid) {
+            return true;
+        }
+    }
+    return false;
+}
+
+void
+ThreadSampler::read(Thread& thread, ProcReader& reader, gint64 now)
+{
+    thread.task->read_stat(reader);
+    double seconds = static_cast<double>(now - thread.lastRead) / 1.0e6;
+    if (seconds > 0.0 && m_clkTck > 0.0) {
+        thread.load = static_cast<double>(thread.task->getCpuUsage()) / (seconds * m_clkTck);
+    }
+    thread.lastRead = now;
+}
+
+// keep the threads in sync with the task dir, new threads are read completely to get the name,
+//   if there are more new threads than reads left, they are added with the next samples
+bool
+ThreadSampler::listThreads(Sampled& sampled, ProcReader& reader, gint64 now, uint32_t& reads)
+{
+    if (!m_scanner.scan(sampled.taskDir.c_str(), m_tids)) {
+        return false;   // process has gone
+    }
+    sampled.threads.eraseIf([this] (const Thread& thread) {
+        if (!std::binary_search(m_tids.begin(), m_tids.end(), static_cast<pid_t>(thread.task->getPid()))) {
+            m_history->release(thread.historyIndex);
+            return true;
+        }
+        return false;
+    });
+    for (auto tid : m_tids) {
+        if (reads > 0u
+         && !sampled.threads.contains(tid)) {
+            --reads;
+            Thread thread;
+            thread.task = std::make_shared<Process>(sampled.taskDir + "/" + std::to_string(tid), tid);
+            thread.task->update(reader);
+            thread.historyIndex = m_history->allocate();
+            thread.lastRead = now;
+            thread.load = 0.0;
+            sampled.threads.insert(tid, thread);
+        }
+    }
+    return true;
+}
+
+bool
+ThreadSampler::sample(ProcReader& reader)
+{
+    gint64 now = g_get_monotonic_time();
+    if (m_lastSample != 0
+     && now - m_lastSample < m_minIntervalUs) {
+        return false;
+    }
+    m_lastSample = now;
+    m_order.clear();
+    uint32_t reads{m_maxReads};
+    for (size_t i = 0; i < m_sampled.size(); ) {
+        auto& sampled = *m_sampled[i];
+        if (listThreads(sampled, reader, now, reads)) {
+            for (auto& thread : sampled.threads) {
+                m_order.push_back(&thread);
+            }
+            ++i;
+        }
+        else {
+            remove(sampled.pid);
+        }
+    }
+    for (size_t i = 0; i < m_order.size() && reads > 0u; ++i) {
+        if (m_next >= m_order.size()) {
+            m_next = 0u;
+        }
+        auto thread = m_order[m_next++];
+        if (thread->lastRead != now) {  // not just created
+            read(*thread, reader, now);
+            --reads;
+        }
+    }
+    m_history->roll();
+    for (auto thread : m_order) {   // the not read keep their last load
+        m_history->set(ProcessHistory::CPU, thread->historyIndex, static_cast<float>(thread->load));
+    }
+    return true;
+}
+
+void
+ThreadSampler::getThreads(long pid, std::vector<const Thread*>& threads) const
+{
+    threads.clear();
+    for (auto& sampled : m_sampled) {
+        if (sampled->pid == pid) {
+            for (auto& thread : sampled->threads) {
+                threads.push_back(&thread);
+            }
+            break;
+        }
+    }
+    std::sort(threads.begin(), threads.end(), [this] (const Thread* a, const Thread* b) {
+        return m_history->sum(ProcessHistory::CPU, a->historyIndex) > m_history->sum(ProcessHistory::CPU, b->historyIndex);
+    });
+}
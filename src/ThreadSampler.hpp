@@ -0,0 +1,109 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <memory>
+#include <algorithm>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include <glib.h>
+
+#include "Process.hpp"
+#include "ProcReader.hpp"
+#include "ProcessHistory.hpp"
+#include "PidScanner.hpp"
+#include "PidMap.hpp"
+
+// samples the threads (/proc/[pid]/task) of selected processes on demand,
+//   the threads are read with the process stat parser.
+//   To bound the effort for processes with many threads
+//   at most maxReads threads are read on each sample (round-robin),
+//   the others keep their last load (new threads count as read as well),
+//   and samples in less than
+//   minInterval are skipped.
+//   The load is given as ratio of one cpu.
+class ThreadSampler
+{
+public:
+    struct Thread
+    {
+        pProcess task;
+        uint32_t historyIndex;
+        gint64 lastRead;    // monotonic us
+        double load;
+    };
+
+    ThreadSampler(uint32_t slots = DEFAULT_SLOTS, const std::string& procDir = "/proc");
+    explicit ThreadSampler(const ThreadSampler& orig) = delete;
+    virtual ~ThreadSampler();
+
+    void add(long pid);
+    void remove(long pid);
+    void clear();
+    bool isSampled(long pid) const;
+    bool empty() const
+    {
+        return m_sampled.empty();
+    }
+    // returns false if skipped by the interval
+    bool sample(ProcReader& reader);
+    // the threads of pid, highest cpu usage over the history first
+    void getThreads(long pid, std::vector<const Thread*>& threads) const;
+    const pProcessHistory& getHistory() const
+    {
+        return m_history;
+    }
+    void setMaxReads(uint32_t maxReads)
+    {
+        m_maxReads = std::max(maxReads, 1u);
+    }
+    uint32_t getMaxReads() const
+    {
+        return m_maxReads;
+    }
+    void setMinInterval(gint64 minIntervalUs)
+    {
+        m_minIntervalUs = minIntervalUs;
+    }
+    static constexpr auto DEFAULT_SLOTS{60u};
+    static constexpr auto DEFAULT_MAX_READS{64u};
+    static constexpr gint64 DEFAULT_MIN_INTERVAL_US{1000000};
+private:
+    struct Sampled
+    {
+        long pid;
+        std::string taskDir;
+        PidMap<Thread> threads;
+    };
+    bool listThreads(Sampled& sampled, ProcReader& reader, gint64 now, uint32_t& reads);
+    void read(Thread& thread, ProcReader& reader, gint64 now);
+
+    std::string m_procDir;
+    pProcessHistory m_history;
+    std::vector<std::unique_ptr<Sampled>> m_sampled;
+    PidScanner m_scanner;
+    std::vector<pid_t> m_tids;      // reused for listing
+    std::vector<Thread*> m_order;   // reused for round-robin
+    size_t m_next;
+    uint32_t m_maxReads;
+    gint64 m_minIntervalUs;
+    gint64 m_lastSample;
+    double m_clkTck;
+};
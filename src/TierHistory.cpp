@@ -0,0 +1,128 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <algorithm>
+
+#include "TierHistory.hpp"
+
+TierHistory::TierHistory(uint32_t points)
+: m_points{std::max(points, 1u)}
+, m_ownState()
+, m_ownValues(getValueCount(m_points))
+, m_state{&m_ownState}
+, m_values{m_ownValues.data()}
+{
+    clear(m_state, m_values, m_points);
+}
+
+TierHistory::TierHistory(uint32_t points, State* state, float* values)
+: m_points{std::max(points, 1u)}
+, m_ownState()
+, m_ownValues()
+, m_state{state}
+, m_values{values}
+{
+    for (uint32_t t = 0; t < CONSOLIDATED; ++t) {
+        if (m_state->head[t] >= m_points) {    // not from us
+            clear(m_state, m_values, m_points);
+            break;
+        }
+    }
+}
+
+void
+TierHistory::clear(State* state, float* values, uint32_t points)
+{
+    for (uint32_t t = 0; t < CONSOLIDATED; ++t) {
+        state->head[t] = 0u;
+        state->count[t] = 0u;
+        state->step[t] = -1l;
+        state->sum[t] = 0.0;
+    }
+    std::fill_n(values, getValueCount(points), 0.0f);
+}
+
+gint64
+TierHistory::getStepUs(Tier tier)
+{
+    switch (tier) {
+    case SEC10:
+        return 10l * G_USEC_PER_SEC;
+    case MIN1:
+        return 60l * G_USEC_PER_SEC;
+    case MIN10:
+        return 600l * G_USEC_PER_SEC;
+    default:
+        return 0l;
+    }
+}
+
+void
+TierHistory::add(double value, gint64 sampleUs)
+{
+    for (uint32_t t = 0; t < CONSOLIDATED; ++t) {
+        const gint64 step = sampleUs / getStepUs(static_cast<Tier>(t + 1u));
+        if (step != m_state->step[t]) {
+            // advance, clearing the steps without samples (e.g. suspended), but at most once around,
+            //   if the clock went back, take it as the next step, so the collected are kept
+            gint64 advance{0l};
+            if (m_state->step[t] >= 0l) {
+                advance = step > m_state->step[t]
+                        ? std::min(step - m_state->step[t], static_cast<gint64>(m_points))
+                        : 1l;
+            }
+            for (gint64 a = 0; a < advance; ++a) {
+                m_state->head[t] = m_state->head[t] + 1u < m_points ? m_state->head[t] + 1u : 0u;
+                for (uint32_t s = 0; s < STATS; ++s) {
+                    m_values[(static_cast<size_t>(t) * STATS + s) * m_points + m_state->head[t]] = 0.0f;
+                }
+            }
+            m_state->step[t] = step;
+            m_state->count[t] = 0u;
+            m_state->sum[t] = 0.0;
+        }
+        float* min = &m_values[(static_cast<size_t>(t) * STATS + MIN) * m_points + m_state->head[t]];
+        float* avg = &m_values[(static_cast<size_t>(t) * STATS + AVG) * m_points + m_state->head[t]];
+        float* max = &m_values[(static_cast<size_t>(t) * STATS + MAX) * m_points + m_state->head[t]];
+        const auto fvalue = static_cast<float>(value);
+        *min = m_state->count[t] > 0u ? std::min(*min, fvalue) : fvalue;
+        *max = m_state->count[t] > 0u ? std::max(*max, fvalue) : fvalue;
+        ++m_state->count[t];
+        m_state->sum[t] += value;
+        *avg = static_cast<float>(m_state->sum[t] / static_cast<double>(m_state->count[t]));
+    }
+}
+
+void
+TierHistory::fill(Tier tier, Stat stat, Buffer<double>& buffer, double scale) const
+{
+    for (uint32_t i = 0; i < m_points; ++i) {
+        buffer.set(i, static_cast<double>(get(tier, stat, i)) * scale);
+    }
+    buffer.refreshSum();
+}
+
+double
+TierHistory::getMax(Tier tier) const
+{
+    double max{};
+    for (uint32_t i = 0; i < m_points; ++i) {
+        max = std::max(max, static_cast<double>(get(tier, MAX, i)));
+    }
+    return max;
+}
@@ -0,0 +1,102 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <glibmm.h>
+#include <vector>
+#include <cstdint>
+
+#include "Buffer.hpp"
+
+// the history of one value consolidated to fixed steps of time
+//   (round robin database like), each tier is a preallocated ring
+//   of min/avg/max, so the memory stays the same however long we run.
+//   The raw values are kept by the monitor, the slot at the head
+//   is the step still collecting.
+//   The storage may be external (see HistoryFile) to keep it across restarts,
+//   as the steps have to survive these, use the real time.
+class TierHistory
+{
+public:
+    enum Tier {
+        RAW = 0,        // as sampled (kept by the monitor)
+        SEC10 = 1,
+        MIN1 = 2,
+        MIN10 = 3,
+        TIERS = 4
+    };
+    enum Stat {
+        MIN = 0,
+        AVG = 1,
+        MAX = 2,
+        STATS = 3
+    };
+
+    static constexpr uint32_t CONSOLIDATED{TIERS - 1u};
+    // all but the values, fixed layout to allow mapping
+    struct State
+    {
+        uint32_t head[CONSOLIDATED];
+        uint32_t count[CONSOLIDATED];
+        gint64 step[CONSOLIDATED];      // the step collected at the head, -1 before the first sample
+        double sum[CONSOLIDATED];
+    };
+
+    TierHistory(uint32_t points);
+    // use the external storage, values has getValueCount(points) entries,
+    //   expected to be initialized with clear
+    TierHistory(uint32_t points, State* state, float* values);
+    explicit TierHistory(const TierHistory& orig) = delete;
+    virtual ~TierHistory() = default;
+
+    static void clear(State* state, float* values, uint32_t points);
+    static constexpr size_t getValueCount(uint32_t points)
+    {
+        return static_cast<size_t>(CONSOLIDATED) * STATS * points;
+    }
+
+    // add a sample taken at sampleUs (real time, a step back is taken as the next step)
+    void add(double value, gint64 sampleUs);
+    // i = 0 oldest ... getPoints() - 1 newest, empty steps are 0
+    float get(Tier tier, Stat stat, uint32_t i) const
+    {
+        const uint32_t t = tier - 1u;
+        uint32_t slot = m_state->head[t] + 1u + i;
+        if (slot >= m_points) {
+            slot -= m_points;
+        }
+        return m_values[(static_cast<size_t>(t) * STATS + stat) * m_points + slot];
+    }
+    // copy the (scaled) values of tier to buffer
+    void fill(Tier tier, Stat stat, Buffer<double>& buffer, double scale = 1.0) const;
+    // the maximum of the ring e.g. to scale
+    double getMax(Tier tier) const;
+    uint32_t getPoints() const
+    {
+        return m_points;
+    }
+    // us per point, 0 for raw
+    static gint64 getStepUs(Tier tier);
+private:
+    uint32_t m_points;
+    State m_ownState;
+    std::vector<float> m_ownValues;
+    State* m_state;
+    float* m_values;                // [tier][stat][slot]
+};
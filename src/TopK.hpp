@@ -0,0 +1,73 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <vector>
+#include <algorithm>
+
+// select the k entries with the highest keys in a single pass,
+//   keeps a min heap of k entries so the smallest is replaced first,
+//   this is O(n log k) and the storage is reused on each reset.
+template<typename K, typename V>
+class TopK
+{
+public:
+    struct Entry
+    {
+        K key;
+        V value;
+    };
+
+    TopK() = default;
+    explicit TopK(const TopK& orig) = delete;
+    virtual ~TopK() = default;
+
+    void reset(size_t k)
+    {
+        m_k = k;
+        m_heap.clear();
+        m_heap.reserve(k);
+    }
+    void add(const K& key, const V& value)
+    {
+        if (m_heap.size() < m_k) {
+            m_heap.push_back(Entry{key, value});
+            std::push_heap(m_heap.begin(), m_heap.end(), greater);
+        }
+        else if (m_k > 0u && m_heap.front().key < key) {
+            std::pop_heap(m_heap.begin(), m_heap.end(), greater);
+            m_heap.back() = Entry{key, value};
+            std::push_heap(m_heap.begin(), m_heap.end(), greater);
+        }
+    }
+    // highest key first, call once after adding as this ends the heap
+    const std::vector<Entry>& sorted()
+    {
+        std::sort_heap(m_heap.begin(), m_heap.end(), greater);
+        return m_heap;
+    }
+private:
+    static bool greater(const Entry& a, const Entry& b)
+    {
+        return b.key < a.key;
+    }
+
+    size_t m_k{};
+    std::vector<Entry> m_heap;
+};
@@ -0,0 +1,66 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+
+// hand the latest value from one writer thread to one reader thread without locking,
+//   the writer fills back() and publishes it, the reader takes the latest with front().
+//   The third buffer is the one exchanged between them, so neither waits on the other
+//   and the values are reused (back() holds an older value that has to be overwritten).
+template<typename T>
+class TripleBuffer
+{
+public:
+    TripleBuffer() = default;
+    explicit TripleBuffer(const TripleBuffer& orig) = delete;
+    virtual ~TripleBuffer() = default;
+
+    // writer only
+    T& back()
+    {
+        return m_buffers[m_back];
+    }
+    void publish()
+    {
+        m_back = m_middle.exchange(m_back | FRESH, std::memory_order_acq_rel) & INDEX;
+    }
+    // reader only, stays the same until the next call
+    const T& front()
+    {
+        if (m_middle.load(std::memory_order_relaxed) & FRESH) {
+            m_front = m_middle.exchange(m_front, std::memory_order_acq_rel) & INDEX;
+        }
+        return m_buffers[m_front];
+    }
+    bool isFresh() const
+    {
+        return m_middle.load(std::memory_order_relaxed) & FRESH;
+    }
+private:
+    static constexpr uint32_t INDEX{0x3u};
+    static constexpr uint32_t FRESH{0x4u};
+
+    std::array<T, 3> m_buffers;
+    uint32_t m_back{0u};
+    std::atomic<uint32_t> m_middle{1u};
+    uint32_t m_front{2u};
+};
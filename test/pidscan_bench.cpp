@@ -0,0 +1,142 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <map>
+#include <cstdlib>
+#include <unistd.h>
+#include <dirent.h>
+
+#include "PidScanner.hpp"
+
+// compares the readdir loop ProcessesBase used with the PidScanner,
+//   both look up the found pids in a map as ProcessesBase does
+//   (find for each resp. a merge), on a synthetic /proc tree
+//   so the result does not depend on the running system.
+//   Run with meson test --benchmark, or pass processes and rounds.
+
+static void
+createTree(const std::filesystem::path& dir, uint32_t processes)
+{
+    static const char* others[] = {"acpi", "bus", "driver", "fs", "irq", "net", "sys", "sysvipc", "tty", "self", "thread-self"};
+    static const char* files[] = {"buddyinfo", "cmdline", "cpuinfo", "diskstats", "loadavg", "meminfo", "stat", "uptime", "version", "vmstat", "zoneinfo"};
+    std::filesystem::create_directories(dir);
+    for (auto other : others) {
+        std::filesystem::create_directory(dir / other);
+    }
+    for (auto file : files) {
+        std::ofstream out(dir / file);
+    }
+    for (uint32_t i = 0; i < processes; ++i) {
+        // leave some gaps as real pids have
+        std::filesystem::create_directory(dir / std::to_string(1u + i * 3u));
+    }
+}
+
+static size_t
+readdirScan(const std::string& dir, std::map<long, int>& known)
+{
+    size_t found{};
+    DIR *d;
+    struct dirent *ent;
+    if ((d = opendir(dir.c_str())) != nullptr) {
+        while ((ent = readdir(d)) != nullptr) {
+            if (ent->d_type == DT_DIR) {
+                long pid = std::atol(ent->d_name);
+                if (pid > 0) {
+                    auto p = known.find(pid);
+                    if (p != known.end()) {
+                        ++found;
+                    }
+                }
+            }
+        }
+        closedir(d);
+    }
+    return found;
+}
+
+static size_t
+getdentsScan(const std::string& dir, std::map<long, int>& known, PidScanner& scanner, std::vector<pid_t>& pids)
+{
+    size_t found{};
+    if (scanner.scan(dir.c_str(), pids)) {
+        auto p = known.begin();
+        for (auto pid : pids) {
+            while (p != known.end() && p->first < pid) {
+                ++p;
+            }
+            if (p != known.end() && p->first == pid) {
+                ++found;
+            }
+        }
+    }
+    return found;
+}
+
+template<typename Scan>
+static double
+measure(const char* name, uint32_t rounds, size_t& found, Scan scan)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < rounds; ++r) {
+        found = scan();
+    }
+    auto end = std::chrono::steady_clock::now();
+    double us = std::chrono::duration<double, std::micro>(end - start).count() / static_cast<double>(rounds);
+    std::cout << name << " " << us << "us per scan, found " << found << std::endl;
+    return us;
+}
+
+int
+main(int argc, char** argv)
+{
+    uint32_t processes = argc > 1 ? static_cast<uint32_t>(std::atol(argv[1])) : 2000u;
+    uint32_t rounds = argc > 2 ? static_cast<uint32_t>(std::atol(argv[2])) : 200u;
+    auto dir = std::filesystem::temp_directory_path() / ("pidscan_bench" + std::to_string(getpid()));
+    createTree(dir, processes);
+    std::map<long, int> known;
+    for (uint32_t i = 0; i < processes; i += 2u) {  // every other is known
+        known.emplace(1l + i * 3l, 0);
+    }
+    PidScanner scanner;
+    std::vector<pid_t> pids;
+    size_t foundReaddir{}, foundGetdents{};
+    double readdirUs = measure("readdir ", rounds, foundReaddir, [&] {
+        return readdirScan(dir.string(), known);
+    });
+    double getdentsUs = measure("getdents", rounds, foundGetdents, [&] {
+        return getdentsScan(dir.string(), known, scanner, pids);
+    });
+    std::cout << "processes " << processes
+              << " speedup " << readdirUs / getdentsUs << std::endl;
+    std::filesystem::remove_all(dir);
+    if (foundReaddir != known.size()
+     || foundGetdents != known.size()
+     || pids.size() != processes) {
+        std::cout << "Found " << foundReaddir << " resp. " << foundGetdents
+                  << " expected " << known.size() << std::endl;
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,249 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <chrono>
+#include <string>
+#include <vector>
+#include <map>
+#include <memory>
+#include <cstdlib>
+#include <algorithm>
+#include <unistd.h>
+#include <glibmm.h>
+
+#include "ProcessesBase.hpp"
+#include "PidMap.hpp"
+
+// measures the update (scan plus tree build) of ProcessesBase
+//   on a synthetic /proc tree with the given numbers of processes,
+//   compares the parent lookup of the tree build std::map <> PidMap,
+//   and the properties refresh without and with a filter.
+//   Run with meson test --benchmark, or pass the numbers of processes.
+
+class BenchProcesses
+: public ProcessesBase
+{
+public:
+    BenchProcesses(const std::string& procDir)
+    : ProcessesBase(procDir)
+    {
+    }
+    size_t getCount() const
+    {
+        return mProcesses.size();
+    }
+};
+
+static long
+pidOf(uint32_t i)
+{
+    return 1l + static_cast<long>(i) * 3l;     // leave some gaps as real pids have
+}
+
+static long
+ppidOf(uint32_t i)
+{
+    return i > 0u ? pidOf((i - 1u) / 8u) : 0l;     // a tree 8 wide
+}
+
+static bool
+createTree(const std::filesystem::path& dir, uint32_t processes)
+{
+    for (uint32_t i = 0; i < processes; ++i) {
+        auto pid = pidOf(i);
+        auto ppid = ppidOf(i);
+        auto procDir = dir / std::to_string(pid);
+        std::filesystem::create_directories(procDir);
+        const bool big = i % 100u == 99u;  // some for the filter to find
+        std::ofstream stat(procDir / "stat");
+        stat << pid << " (bench " << i << ") " << (big ? "D " : "S ") << ppid << " " << pid << " " << pid
+             << " 0 -1 4194560 100 0 0 0 " << (i % 100u) << " " << (i % 10u)
+             << " 0 0 20 0 1 0 100 10000000 500 18446744073709551615 1 1 0 0 0 0 0 4096 0 0 0 0 17 0 0 0 0 0 0 0 0 0 0 0 0 0 0\n";
+        std::ofstream status(procDir / "status");
+        status << "Name:\tbench " << i << "\n"
+               << (big ? "State:\tD (disk sleep)\n" : "State:\tS (sleeping)\n")
+               << "Tgid:\t" << pid << "\n"
+               << "Pid:\t" << pid << "\n"
+               << "PPid:\t" << ppid << "\n"
+               << "Uid:\t1000\t1000\t1000\t1000\n"
+               << "Gid:\t1000\t1000\t1000\t1000\n"
+               << "VmPeak:\t   10000 kB\n"
+               << "VmSize:\t   10000 kB\n"
+               << (big ? "VmRSS:\t  600000 kB\n" : "VmRSS:\t    2000 kB\n")
+               << "RssAnon:\t    1500 kB\n"
+               << "RssFile:\t     500 kB\n"
+               << "VmData:\t    1000 kB\n"
+               << "VmStk:\t     132 kB\n"
+               << "VmExe:\t     100 kB\n"
+               << "Threads:\t1\n";
+        if (!status.good() || !stat.good()) {
+            return false;
+        }
+    }
+    return true;
+}
+
+template<typename Run>
+static double
+measureUs(uint32_t rounds, Run run)
+{
+    auto start = std::chrono::steady_clock::now();
+    for (uint32_t r = 0; r < rounds; ++r) {
+        run();
+    }
+    auto end = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::micro>(end - start).count() / static_cast<double>(rounds);
+}
+
+// the rows as ProcessProperties::addProcess creates them for the shown processes
+struct Row
+{
+    long pid;
+    long rss;
+    double load;
+    char state;
+};
+
+static void
+materialize(const pProcess& process, std::vector<Row>& rows)
+{
+    rows.push_back(Row{process->getPid(), process->getVmRssK(), process->getRawLoad(), process->getState()});
+    for (auto& child : process->getChildren()) {
+        auto processChild = std::dynamic_pointer_cast<Process>(child);
+        if (processChild && processChild->isShown()) {
+            materialize(processChild, rows);
+        }
+    }
+}
+
+// the refresh of the properties, update plus rows, without and with a filter
+static bool
+compareFilter(BenchProcesses& procs, uint32_t rounds)
+{
+    std::vector<Row> rows;
+    auto refresh = [&] {
+        procs.update();
+        rows.clear();
+        materialize(procs.findPid(ROOT_PID), rows);
+    };
+    double allUs = measureUs(rounds, refresh);
+    size_t allRows = rows.size();
+    auto filter = std::make_shared<ProcessFilter>();
+    if (!filter->parse("rss>500M && state==D")) {
+        std::cout << "Filter " << filter->getError() << std::endl;
+        return false;
+    }
+    procs.setFilter(filter);
+    double filterUs = measureUs(rounds, refresh);
+    size_t filterRows = rows.size();
+    procs.setFilter(nullptr);
+    std::cout << "  refresh all " << allUs << "us " << allRows << " rows"
+              << " filter " << filterUs << "us " << filterRows << " rows" << std::endl;
+    return filterRows > 0u && filterRows < allRows;
+}
+
+// the parent lookups as buildTree does them
+static void
+compareLookup(uint32_t processes, uint32_t rounds)
+{
+    std::map<long, std::shared_ptr<long>> map;
+    PidMap<std::shared_ptr<long>> pidMap;
+    for (uint32_t i = 0; i < processes; ++i) {
+        auto ppid = std::make_shared<long>(ppidOf(i));
+        map.emplace(pidOf(i), ppid);
+        pidMap.insert(pidOf(i), ppid);
+    }
+    long found{};
+    double mapUs = measureUs(rounds, [&] {
+        for (auto& p : map) {
+            auto pp = map.find(*p.second);
+            if (pp != map.end()) {
+                ++found;
+            }
+        }
+    });
+    double pidMapUs = measureUs(rounds, [&] {
+        for (auto& p : pidMap) {
+            auto pp = pidMap.find(*p);
+            if (pp) {
+                ++found;
+            }
+        }
+    });
+    std::cout << "  lookup std::map " << mapUs << "us"
+              << " PidMap " << pidMapUs << "us"
+              << " speedup " << mapUs / pidMapUs
+              << " (" << found << ")" << std::endl;
+}
+
+static bool
+bench(uint32_t processes, uint32_t rounds)
+{
+    auto dir = std::filesystem::path(Glib::get_tmp_dir()) / Glib::ustring::sprintf("process_bench%d", getpid()).raw();
+    if (!createTree(dir, processes)) {
+        std::cout << "Could not create " << dir << std::endl;
+        std::filesystem::remove_all(dir);
+        return false;
+    }
+    BenchProcesses procs(dir.string());
+    double createUs = measureUs(1u, [&] {
+        procs.update();
+    });
+    double updateUs = measureUs(rounds, [&] {
+        procs.update();
+    });
+    double treeUs = measureUs(rounds, [&] {
+        procs.buildTree();
+    });
+    std::cout << "processes " << processes
+              << " create " << createUs << "us"
+              << " update " << updateUs << "us"
+              << " full buildTree " << treeUs << "us" << std::endl;
+    compareLookup(processes, rounds);
+    bool ret = compareFilter(procs, rounds)
+            && procs.getCount() == processes
+            && procs.findPid(ROOT_PID);
+    std::filesystem::remove_all(dir);
+    if (!ret) {
+        std::cout << "Found " << procs.getCount() << " expected " << processes << std::endl;
+    }
+    return ret;
+}
+
+int
+main(int argc, char** argv)
+{
+    setlocale(LC_ALL, "");      // make locale dependent, and make glib accept u8 const !!!
+    std::vector<uint32_t> sizes;
+    for (int i = 1; i < argc; ++i) {
+        sizes.push_back(static_cast<uint32_t>(std::atol(argv[i])));
+    }
+    if (sizes.empty()) {
+        sizes = {1000u, 10000u, 50000u};
+    }
+    for (auto processes : sizes) {
+        uint32_t rounds = std::max(500000u / processes, 3u);
+        if (!bench(processes, rounds)) {
+            return 1;
+        }
+    }
+    return 0;
+}
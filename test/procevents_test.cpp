@@ -0,0 +1,322 @@
+/* -*- Mode: c++; c-basic-offset: 4; tab-width: 4; coding: utf-8; -*-  */
+/*
+ * Copyright (C) 2026 rpf
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include <iostream>
+#include <fstream>
+#include <filesystem>
+#include <string>
+#include <vector>
+#include <memory>
+#include <unistd.h>
+#include <glibmm.h>
+
+#include "ProcessesBase.hpp"
+#include "ProcEvents.hpp"
+#include "Lifecycle.hpp"
+
+// checks the process list with events from a fake source
+//   on a synthetic /proc tree, so no CAP_NET_ADMIN is needed
+
+class FakeProcEvents
+: public ProcEventSource
+{
+public:
+    bool isConnected() const override
+    {
+        return true;
+    }
+    bool read(std::vector<ProcEvent>& events) override
+    {
+        events.insert(events.end(), m_pending.begin(), m_pending.end());
+        m_pending.clear();
+        bool complete = !m_lost;
+        m_lost = false;
+        return complete;
+    }
+    void add(ProcEvent::Type type, pid_t pid, pid_t ppid = 0)
+    {
+        m_pending.push_back(ProcEvent{type, pid, ppid});
+    }
+    void setLost()
+    {
+        m_lost = true;
+    }
+private:
+    std::vector<ProcEvent> m_pending;
+    bool m_lost{false};
+};
+
+class TestProcesses
+: public ProcessesBase
+{
+public:
+    TestProcesses(const std::string& procDir)
+    : ProcessesBase(procDir)
+    {
+    }
+    size_t getCount() const
+    {
+        return mProcesses.size();
+    }
+};
+
+static bool
+writeProcess(const std::filesystem::path& dir, long pid, long ppid)
+{
+    auto procDir = dir / std::to_string(pid);
+    std::filesystem::create_directories(procDir);
+    std::ofstream stat(procDir / "stat");
+    stat << pid << " (test" << pid << ") S " << ppid << " " << pid << " " << pid
+         << " 0 -1 4194560 100 0 0 0 10 1 0 0 20 0 1 0 100 10000000 500 18446744073709551615 1 1 0 0 0 0 0 4096 0 0 0 0 17 0 0 0 0 0 0 0 0 0 0 0 0 0 0\n";
+    std::ofstream status(procDir / "status");
+    status << "Name:\ttest" << pid << "\n"
+           << "State:\tS (sleeping)\n"
+           << "Pid:\t" << pid << "\n"
+           << "PPid:\t" << ppid << "\n"
+           << "Uid:\t1000\t1000\t1000\t1000\n"
+           << "Gid:\t1000\t1000\t1000\t1000\n"
+           << "VmRSS:\t    2000 kB\n"
+           << "Threads:\t1\n";
+    return stat.good() && status.good();
+}
+
+static bool
+check(bool condition, const char* what)
+{
+    if (!condition) {
+        std::cout << "Failed " << what << std::endl;
+    }
+    return condition;
+}
+
+static bool
+events_test(const std::filesystem::path& dir)
+{
+    std::cout << "events_test" << std::endl;
+    writeProcess(dir, 1, 0);
+    writeProcess(dir, 10, 1);
+    writeProcess(dir, 11, 1);
+    TestProcesses procs(dir.string());
+    auto source = std::make_unique<FakeProcEvents>();
+    auto events = source.get();
+    procs.setProcEvents(std::move(source), 4u);
+    procs.update();     // the first update lists the directory
+    if (!check(procs.getCount() == 3u, "initial scan")) {
+        return false;
+    }
+    writeProcess(dir, 20, 10);
+    writeProcess(dir, 30, 1);   // without event this is found on the next full scan
+    events->add(ProcEvent::Type::Fork, 20, 10);
+    procs.update();
+    auto forked = procs.findPid(20);
+    if (!check(forked && procs.getCount() == 4u && !procs.findPid(30), "fork")
+     || !check(forked->getParent()
+               && &*forked->getParent() == static_cast<psc::gl::TreeNode2*>(procs.findPid(10).get()), "forked parent")) {
+        return false;
+    }
+    std::filesystem::remove_all(dir / "11");
+    events->add(ProcEvent::Type::Exit, 11);
+    procs.update();     // exited are closed in two steps
+    auto exited = procs.findPid(11);
+    if (!check(exited && exited->getStage() == psc::gl::TreeNodeState::Close, "exit close")) {
+        return false;
+    }
+    procs.update();
+    if (!check(!procs.findPid(11), "exit removed")) {
+        return false;
+    }
+    procs.update();     // full scan
+    if (!check(procs.findPid(30) && procs.getCount() == 4u, "full scan")) {
+        return false;
+    }
+    writeProcess(dir, 40, 1);
+    events->setLost();  // lost events require a full scan
+    procs.update();
+    return check(procs.findPid(40) && procs.getCount() == 5u, "lost events");
+}
+
+// spawns and exits are logged after the first update, the oldest are overwritten
+static bool
+lifecycle_test(const std::filesystem::path& dir)
+{
+    std::cout << "lifecycle_test" << std::endl;
+    LifecycleLog ring{3u};     // rounded to 4
+    for (pid_t pid = 1; pid <= 6; ++pid) {
+        ring.add(LifecycleEvent{LifecycleEvent::Type::Spawn, pid, 1, "ring", 0, 0});
+    }
+    std::vector<LifecycleEvent> events;
+    uint64_t since = ring.read(0u, events);
+    if (!check(ring.getCapacity() == 4u && since == 6u && events.size() == 4u
+               && events.front().pid == 3 && events.back().pid == 6, "ring overwrite")) {
+        return false;
+    }
+    events.clear();
+    ring.add(LifecycleEvent{LifecycleEvent::Type::Exit, 6, 1, "ring", 0, 10});
+    since = ring.read(since, events);
+    if (!check(since == 7u && events.size() == 1u
+               && events[0].type == LifecycleEvent::Type::Exit
+               && events[0].getName() == "ring"
+               && ring.getSpawns() == 6u && ring.getExits() == 1u, "ring since")) {
+        return false;
+    }
+
+    writeProcess(dir, 1, 0);
+    writeProcess(dir, 10, 1);
+    TestProcesses procs(dir.string());
+    auto lifecycle = procs.getLifecycle();
+    procs.update();     // the existing are not logged
+    if (!check(lifecycle->getSpawns() == 0u, "initial not logged")) {
+        return false;
+    }
+    writeProcess(dir, 20, 10);
+    std::filesystem::remove_all(dir / "10");
+    procs.update();
+    events.clear();
+    lifecycle->read(0u, events);
+    return check(events.size() == 2u
+              && events[0].type == LifecycleEvent::Type::Spawn
+              && events[0].pid == 20 && events[0].ppid == 10
+              && events[0].getName() == "test20"
+              && events[1].type == LifecycleEvent::Type::Exit
+              && events[1].pid == 10
+              && events[1].getName() == "test10", "spawn exit");
+}
+
+// the matching processes are shown with their ancestors
+static bool
+filter_test(const std::filesystem::path& dir)
+{
+    std::cout << "filter_test" << std::endl;
+    ProcessFilter invalid;
+    if (!check(!invalid.parse("foo==1")
+            && !invalid.parse("rss>abc")
+            && !invalid.parse("pid==1 &&")
+            && !invalid.parse("(pid==1")
+            && !invalid.getError().empty(), "invalid")) {
+        return false;
+    }
+    writeProcess(dir, 1, 0);
+    writeProcess(dir, 10, 1);
+    writeProcess(dir, 11, 1);
+    writeProcess(dir, 20, 10);
+    TestProcesses procs(dir.string());
+    procs.update();
+    auto filter = std::make_shared<ProcessFilter>();
+    if (!check(filter->parse("name==test20 || (rss>2M && !pid<5)"), "parse")) {
+        std::cout << filter->getError() << std::endl;
+        return false;
+    }
+    procs.setFilter(filter);
+    procs.update();
+    if (!check(procs.findPid(20)->isShown()
+            && procs.findPid(10)->isShown()
+            && procs.findPid(1)->isShown()
+            && !procs.findPid(11)->isShown()
+            && !procs.findPid(1)->isFilterMatch(), "shown")) {
+        return false;
+    }
+    filter = std::make_shared<ProcessFilter>();
+    if (!check(filter->parse("user==1000 && state==S && rss>=2000K && name~test1"), "parse 2")) {
+        std::cout << filter->getError() << std::endl;
+        return false;
+    }
+    procs.setFilter(filter);
+    if (!check(procs.findPid(10)->isShown()
+            && procs.findPid(11)->isShown()
+            && !procs.findPid(20)->isShown(), "shown 2")) {
+        return false;
+    }
+    procs.setFilter(nullptr);
+    return check(procs.findPid(20)->isShown(), "shown all");
+}
+
+// the snapshot is only published while subscribed, and keeps the tree
+static bool
+snapshot_test(const std::filesystem::path& dir)
+{
+    std::cout << "snapshot_test" << std::endl;
+    writeProcess(dir, 1, 0);
+    writeProcess(dir, 10, 1);
+    writeProcess(dir, 11, 1);
+    writeProcess(dir, 20, 10);
+    TestProcesses procs(dir.string());
+    procs.update();
+    procs.publishSnapshot();
+    if (!check(!procs.getSnapshot(), "unsubscribed")) {
+        return false;
+    }
+    procs.subscribeSnapshot();
+    auto first = procs.getSnapshot();
+    if (!check(first && first->size() == 4, "subscribed")) {
+        return false;
+    }
+    procs.publishSnapshot();
+    auto snapshot = procs.getSnapshot();
+    if (!check(snapshot != first
+            && snapshot->getSerial() == first->getSerial() + 1, "serial")) {
+        return false;
+    }
+    auto init = snapshot->find(1);
+    auto process = snapshot->find(20);
+    if (!check(init && process
+            && init->getParent() == ProcessSnapshot::NONE
+            && snapshot->get(process->getParent()).getPid() == 10
+            && snapshot->get(snapshot->get(process->getParent()).getParent()).getPid() == 1
+            && process->getFirstChild() == ProcessSnapshot::NONE
+            && process->getInternedName() == "test20", "links")) {
+        return false;
+    }
+    uint32_t children{};
+    for (uint32_t child = init->getFirstChild(); child != ProcessSnapshot::NONE; child = snapshot->get(child).getNextSibling()) {
+        ++children;
+    }
+    if (!check(children == 2, "children")) {
+        return false;
+    }
+    procs.unsubscribeSnapshot();
+    return check(!procs.getSnapshot()
+              && snapshot->find(11), "released");    // the held stays valid
+}
+
+int
+main(int argc, char** argv)
+{
+    setlocale(LC_ALL, "");      // make locale dependent, and make glib accept u8 const !!!
+    auto dir = std::filesystem::path(Glib::get_tmp_dir()) / Glib::ustring::sprintf("procevents_test%d", getpid()).raw();
+    bool ret = events_test(dir);
+    std::filesystem::remove_all(dir);
+    if (!ret) {
+        return 1;
+    }
+    ret = lifecycle_test(dir);
+    std::filesystem::remove_all(dir);
+    if (!ret) {
+        return 2;
+    }
+    ret = filter_test(dir);
+    std::filesystem::remove_all(dir);
+    if (!ret) {
+        return 3;
+    }
+    ret = snapshot_test(dir);
+    std::filesystem::remove_all(dir);
+    if (!ret) {
+        return 4;
+    }
+    return 0;
+}